@@ -16,8 +16,8 @@ function Compile-Shaders {
         return
     }
 
-    # Get all .vert and .frag files in the directory (including subdirectories)
-    $shaderFiles = Get-ChildItem -Path $DirectoryPath -Include "*.vert", "*.frag" -Recurse
+    # Get all .vert, .frag and .comp files in the directory (including subdirectories)
+    $shaderFiles = Get-ChildItem -Path $DirectoryPath -Include "*.vert", "*.frag", "*.comp" -Recurse
 
     foreach ($shaderFile in $shaderFiles) {
         $filePath = $shaderFile.FullName
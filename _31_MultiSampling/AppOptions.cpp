@@ -0,0 +1,84 @@
+#include "AppOptions.h"
+
+#include <stdexcept>
+
+#include "Vulkan/GraphicPipeline/GraphicsPipelineMgr.h"
+
+bool AppOptions::headless = false;
+uint32_t AppOptions::frameCount = 0;
+uint32_t AppOptions::framesInFlight = 0;
+bool AppOptions::fenceSync = false;
+std::string AppOptions::profileOutput{};
+uint32_t AppOptions::instanceCount = 1;
+uint32_t AppOptions::cullBenchmarkObjects = 0;
+bool AppOptions::coldPipelineCache = false;
+bool AppOptions::prebuildPipelines = false;
+uint32_t AppOptions::stagingRingMegabytes = 0;
+
+void AppOptions::parse(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--headless")
+        {
+            headless = true;
+        }
+        else if (argument == "--frames" && i + 1 < argc)
+        {
+            frameCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (argument == "--frames-in-flight" && i + 1 < argc)
+        {
+            framesInFlight = static_cast<uint32_t>(std::stoul(argv[++i]));
+            if (framesInFlight < 1 || framesInFlight > GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT)
+                throw std::invalid_argument("--frames-in-flight must be between 1 and " +
+                                            std::to_string(GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT));
+        }
+        else if (argument == "--fence-sync")
+        {
+            fenceSync = true;
+        }
+        else if (argument == "--profile" && i + 1 < argc)
+        {
+            profileOutput = argv[++i];
+        }
+        else if (argument == "--instances" && i + 1 < argc)
+        {
+            instanceCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+            if (instanceCount == 0)
+                throw std::invalid_argument("--instances must be at least 1");
+        }
+        else if (argument == "--cold-pipeline-cache")
+        {
+            coldPipelineCache = true;
+        }
+        else if (argument == "--prebuild-pipelines")
+        {
+            prebuildPipelines = true;
+        }
+        else if (argument == "--staging-ring-mb" && i + 1 < argc)
+        {
+            stagingRingMegabytes = static_cast<uint32_t>(std::stoul(argv[++i]));
+            if (stagingRingMegabytes == 0)
+                throw std::invalid_argument("--staging-ring-mb must be at least 1");
+        }
+        else if (argument == "--cull-benchmark")
+        {
+            // An optional count may follow, the default matches the size the kernels are tuned for
+            cullBenchmarkObjects = 1000000;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                cullBenchmarkObjects = static_cast<uint32_t>(std::stoul(argv[++i]));
+            if (cullBenchmarkObjects == 0)
+                throw std::invalid_argument("--cull-benchmark needs at least 1 object");
+        }
+        else
+        {
+            throw std::invalid_argument("unknown argument: " + argument);
+        }
+    }
+
+    // Without a window there is nothing to close, so a headless run always has a frame budget
+    if (headless && frameCount == 0)
+        frameCount = 1000;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+class AppOptions
+{
+public:
+    static void parse(int argc, char* argv[]);
+
+    // Renders into offscreen images without creating a window or surface, for machines without a display
+    static bool headless;
+    // Stops after this many frames and reports the frame rate, 0 runs until the window is closed
+    static uint32_t frameCount;
+    // Overrides the number of frames in flight (1 to 4), 0 keeps the default. Keys 1 to 4 change it while running.
+    static uint32_t framesInFlight;
+    // Synchronizes with one fence per submission even when timeline semaphores are available
+    static bool fenceSync;
+    // When set, per frame stage timings are written to <profileOutput>.csv and <profileOutput>.json on exit
+    static std::string profileOutput;
+    // Number of copies of the model, drawn with one instanced draw call
+    static uint32_t instanceCount;
+    // When not 0, times CPU frustum culling of this many random objects and exits without creating a renderer
+    static uint32_t cullBenchmarkObjects;
+    // Ignores the pipeline cache on disk, so the cold startup time can be compared with a warm one
+    static bool coldPipelineCache;
+    // Compiles every pipeline permutation at startup and reports how long that took, instead of compiling each on first use
+    static bool prebuildPipelines;
+    // Overrides the size of the staging ring in megabytes, 0 keeps the default. Uploads larger than the ring get their own buffer.
+    static uint32_t stagingRingMegabytes;
+};
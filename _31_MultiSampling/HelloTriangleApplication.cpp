@@ -6,14 +6,21 @@
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
+#include "AppOptions.h"
 #include "Vulkan/DebugMessengerMgr.h"
+#include "Vulkan/DeletionQueueMgr.h"
 #include "Vulkan/DepthBufferMgr.h"
 #include "Vulkan/DescriptorMgr.h"
 #include "Vulkan/ExtensionsMgr.h"
 #include "Vulkan/FrameBuffersMgr.h"
+#include "Vulkan/GpuTimelineMgr.h"
 #include "Vulkan/LogicalDevicesMgr.h"
 #include "Vulkan/MsaaMgr.h"
 #include "Vulkan/PhysicalDevicesMgr.h"
@@ -21,11 +28,22 @@
 #include "Vulkan/SyncObjectsMgr.h"
 #include "Vulkan/ValidationLayerMgr.h"
 #include "Vulkan/CommandBuffers/CommandBuffersMgr.h"
+#include "Vulkan/Culling/CullingMgr.h"
 #include "Vulkan/GraphicPipeline/GraphicsPipelineMgr.h"
+#include "Vulkan/GraphicPipeline/PipelineCacheMgr.h"
+#include "Vulkan/GraphicPipeline/PipelineLibrary.h"
+#include "Vulkan/GraphicPipeline/PipelineStateCache.h"
+#include "Vulkan/GraphicPipeline/Shaders/ShaderRegistry.h"
+#include "Vulkan/Instancing/InstanceBufferMgr.h"
+#include "Vulkan/Memory/MemoryAllocatorMgr.h"
+#include "Vulkan/Memory/StagingBufferMgr.h"
 #include "Vulkan/Models/ModelsMgr.h"
+#include "Vulkan/Profiling/FrameProfiler.h"
+#include "Vulkan/Profiling/GpuProfiler.h"
 #include "Vulkan/SwapChain/SwapChainMgr.h"
 #include "Vulkan/Textures/TextureMgr.h"
 #include "Vulkan/UniformBuffer/UniformBufferMgr.h"
+#include "Vulkan/Vertex/GeometryPoolMgr.h"
 #include "Vulkan/Vertex/VertexDataMgr.h"
 
 constexpr uint32_t WIDTH = 800;
@@ -34,11 +52,13 @@ constexpr uint32_t HEIGHT = 600;
 GLFWwindow* HelloTriangleApplication::window = nullptr;
 uint32_t HelloTriangleApplication::currentFrame = 0;
 bool framebufferResized = false;
+uint32_t requestedFramesInFlight = 0; // Set from the key callback, applied between two frames
 
 void HelloTriangleApplication::run()
 {
     ValidationLayerMgr::initialize();
-    initWindow();
+    if (!AppOptions::headless)
+        initWindow();
     initVulkan();
     mainLoop();
     cleanup();
@@ -46,53 +66,189 @@ void HelloTriangleApplication::run()
 
 void HelloTriangleApplication::initVulkan()
 {
+    const auto startTime = std::chrono::steady_clock::now();
     createInstance();
     DebugMessengerMgr::setupDebugMessenger(instance);
-    SurfaceMgr::createSurface(instance, window);
+    if (!AppOptions::headless)
+        SurfaceMgr::createSurface(instance, window);
+    SwapChainMgr::offscreenExtent = {WIDTH, HEIGHT};
+    if (AppOptions::framesInFlight != 0)
+        GraphicsPipelineMgr::framesInFlight = AppOptions::framesInFlight;
     PhysicalDevicesMgr::pickPhysicalDevice(instance);
     LogicalDevicesMgr::createLogicalDevice();
+    GpuTimelineMgr::createTimeline();
+    MemoryAllocatorMgr::createAllocator();
     SwapChainMgr::createSwapChain();
     SwapChainMgr::createImageViews();
     DescriptorMgr::createDescriptorSetLayout();
     MsaaMgr::createColorResources();
     DepthBufferMgr::createDepthResources();
+    PipelineCacheMgr::createPipelineCache();
+    const auto pipelineStartTime = std::chrono::steady_clock::now();
     GraphicsPipelineMgr::createGraphicsPipeline("Shaders/TriangleVert.spv", "Shaders/TriangleFrag.spv");
+    CullingMgr::createCullingPipeline("Shaders/CullComp.spv");
+    const auto pipelineEndTime = std::chrono::steady_clock::now();
+    if (AppOptions::prebuildPipelines)
+        prebuildPipelines();
     FrameBuffersMgr::createFramebuffers();
     CommandBuffersMgr::createCommandPool();
+    GpuProfiler::createProfiler();
+    if (AppOptions::stagingRingMegabytes != 0)
+        StagingBufferMgr::ringSize = static_cast<VkDeviceSize>(AppOptions::stagingRingMegabytes) * 1024 * 1024;
+    StagingBufferMgr::createStagingBuffer();
     TextureMgr::createTextureImage("../Textures/viking_room.png");
+    // The texture uploads and mipmap blits run on the GPU while the model is parsed
+    CommandBuffersMgr::submitUploadBatch();
     TextureMgr::createTextureImageView();
     TextureMgr::createTextureSampler();
     ModelsMgr::loadModel();
-    VertexDataMgr::createVertexBuffer();
-    VertexDataMgr::createIndexBuffer();
+    VertexDataMgr::uploadModel();
+    ModelsMgr::releaseModel();
+    CommandBuffersMgr::submitUploadBatch();
+    InstanceBufferMgr::createInstances(AppOptions::instanceCount);
+    InstanceBufferMgr::createInstanceBuffers();
+    CullingMgr::createCullingResources();
     UniformBufferMgr::createUniformBuffers();
     DescriptorMgr::createDescriptorPool();
     DescriptorMgr::createDescriptorSets();
     CommandBuffersMgr::createCommandBuffers();
     SyncObjectsMgr::createSyncObjects();
+    FrameProfiler::createProfiler();
+    MemoryAllocatorMgr::printStats();
+
+    const auto toMilliseconds = [](auto duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+    std::cout << "startup " << toMilliseconds(std::chrono::steady_clock::now() - startTime) << " ms, pipelines "
+              << toMilliseconds(pipelineEndTime - pipelineStartTime) << " ms with a " << (PipelineCacheMgr::warm ? "warm" : "cold")
+              << " pipeline cache\n";
+}
+
+void HelloTriangleApplication::prebuildPipelines()
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    std::vector<PipelineKey> keys;
+    for (uint32_t samples = VK_SAMPLE_COUNT_1_BIT; samples <= PhysicalDevicesMgr::msaaSamples; samples <<= 1)
+    {
+        // A multisampled render pass always resolves, so single sampled permutations only exist without MSAA
+        if (samples == VK_SAMPLE_COUNT_1_BIT && PhysicalDevicesMgr::msaaSamples != VK_SAMPLE_COUNT_1_BIT)
+            continue;
+
+        for (const BlendMode blendMode : {BlendMode::Opaque, BlendMode::AlphaBlend, BlendMode::Additive})
+            for (const VkCullModeFlags cullMode : {VK_CULL_MODE_BACK_BIT, VK_CULL_MODE_NONE, VK_CULL_MODE_FRONT_BIT})
+                for (const VertexInput vertexInput : {VertexInput::Quantized, VertexInput::FullPrecision})
+                {
+                    PipelineKey key;
+                    key.samples = static_cast<VkSampleCountFlagBits>(samples);
+                    key.blendMode = blendMode;
+                    key.cullMode = cullMode;
+                    key.vertexInput = vertexInput;
+                    key.features.quantizedDecode = vertexInput == VertexInput::Quantized;
+                    keys.push_back(key);
+                }
+    }
+
+    // At high sample counts the set outgrows the default cache size, which would evict the first permutations again
+    PipelineStateCache::maxPipelines = std::max(PipelineStateCache::maxPipelines, keys.size());
+
+    std::vector<std::shared_future<VkPipeline>> builds;
+    builds.reserve(keys.size());
+    for (const PipelineKey& key : keys)
+        builds.push_back(PipelineLibrary::request(key));
+
+    for (const auto& build : builds)
+        build.wait();
+    std::cout << builds.size() << " pipeline permutations built in "
+              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count() << " ms\n";
 }
 
 void HelloTriangleApplication::mainLoop()
 {
-    while (!glfwWindowShouldClose(window))
+    const auto startTime = std::chrono::steady_clock::now();
+    uint32_t framesDrawn = 0;
+    while (AppOptions::headless || !glfwWindowShouldClose(window))
     {
-        glfwPollEvents();
+        if (!AppOptions::headless)
+            glfwPollEvents();
+        if (requestedFramesInFlight != 0)
+        {
+            setFramesInFlight(requestedFramesInFlight);
+            requestedFramesInFlight = 0;
+        }
+        FrameProfiler::beginFrame();
         drawFrame();
+        FrameProfiler::endFrame();
+
+        if (AppOptions::frameCount != 0 && ++framesDrawn == AppOptions::frameCount)
+            break;
     }
 
     vkDeviceWaitIdle(LogicalDevicesMgr::device);
+
+    if (AppOptions::frameCount != 0)
+    {
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        std::cout << framesDrawn << " frames in " << seconds << " s, " << framesDrawn / seconds << " fps\n";
+    }
+
+    FrameProfiler::printReport();
+    GpuProfiler::printUploadTimings();
+    if (!AppOptions::profileOutput.empty())
+    {
+        FrameProfiler::writeCsv(AppOptions::profileOutput + ".csv");
+        FrameProfiler::writeJson(AppOptions::profileOutput + ".json");
+    }
+}
+
+void HelloTriangleApplication::setFramesInFlight(uint32_t count)
+{
+    if (count < 1 || count > GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT)
+        throw std::invalid_argument("frames in flight must be between 1 and " + std::to_string(GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT));
+    if (count == GraphicsPipelineMgr::framesInFlight)
+        return;
+
+    // Every frame slot may still be referenced by a submission, so nothing can be released before the device is idle
+    vkDeviceWaitIdle(LogicalDevicesMgr::device);
+
+    SyncObjectsMgr::destroySyncObjects();
+    GpuProfiler::destroyFrameScopes();
+    CommandBuffersMgr::destroyCommandBuffers();
+    DescriptorMgr::destroyDescriptorPool();
+    UniformBufferMgr::destroyUniformBuffers();
+    CullingMgr::destroyCullingResources();
+    InstanceBufferMgr::destroyInstanceBuffers();
+
+    GraphicsPipelineMgr::framesInFlight = count;
+    currentFrame = 0;
+
+    InstanceBufferMgr::createInstanceBuffers();
+    CullingMgr::createCullingResources();
+    UniformBufferMgr::createUniformBuffers();
+    DescriptorMgr::createDescriptorPool();
+    DescriptorMgr::createDescriptorSets();
+    CommandBuffersMgr::createCommandBuffers();
+    GpuProfiler::createFrameScopes();
+    SyncObjectsMgr::createSyncObjects();
+
+    std::cout << "frames in flight: " << count << '\n';
 }
 
 void HelloTriangleApplication::cleanup()
 {
+    DeletionQueueMgr::flush();
     SyncObjectsMgr::destroySyncObjects();
+    StagingBufferMgr::destroyStagingBuffer();
+    GpuProfiler::destroyProfiler();
     CommandBuffersMgr::destroyCommandPool();
     DescriptorMgr::destroyDescriptorPool();
     UniformBufferMgr::destroyUniformBuffers();
-    VertexDataMgr::destroyIndexBuffer();
-    VertexDataMgr::destroyVertexBuffer();
+    CullingMgr::destroyCullingResources();
+    InstanceBufferMgr::destroyInstanceBuffers();
+    GeometryPoolMgr::destroyPool();
     FrameBuffersMgr::destroyFramebuffers();
+    CullingMgr::destroyCullingPipeline();
     GraphicsPipelineMgr::destroyGraphicsPipeline();
+    ShaderRegistry::destroyRegistry();
+    PipelineCacheMgr::savePipelineCache();
+    PipelineCacheMgr::destroyPipelineCache();
     DepthBufferMgr::destroyDepthResources();
     MsaaMgr::destroyColorResources();
     DescriptorMgr::destroyDescriptorSetLayout();
@@ -101,14 +257,19 @@ void HelloTriangleApplication::cleanup()
     TextureMgr::destroyTextureSampler();
     TextureMgr::destroyTextureImageView();
     TextureMgr::destroyTextureImage();
+    MemoryAllocatorMgr::destroyAllocator();
+    GpuTimelineMgr::destroyTimeline();
     LogicalDevicesMgr::destroyLogicalDevice();
     if (ValidationLayerMgr::enableValidationLayers)
         DebugMessengerMgr::destroyDebugUtilsMessengerExt(instance, nullptr);
 
     SurfaceMgr::destroySurface(instance);
     vkDestroyInstance(instance, nullptr);
-    glfwDestroyWindow(window);
-    glfwTerminate();
+    if (!AppOptions::headless)
+    {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    }
 }
 
 static void framebufferResizeCallback(GLFWwindow* window, int width, int height)
@@ -116,6 +277,28 @@ static void framebufferResizeCallback(GLFWwindow* window, int width, int height)
     framebufferResized = true;
 }
 
+static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    if (action != GLFW_PRESS)
+        return;
+
+    if (key >= GLFW_KEY_1 && key <= GLFW_KEY_4)
+        requestedFramesInFlight = static_cast<uint32_t>(key - GLFW_KEY_1 + 1);
+
+    // B, C, T and A switch the pipeline permutation, frames keep drawing with a ready one until it is compiled
+    PipelineKey& pipelineKey = GraphicsPipelineMgr::pipelineKey;
+    if (key == GLFW_KEY_B)
+        pipelineKey.blendMode = static_cast<BlendMode>((static_cast<int>(pipelineKey.blendMode) + 1) % 3);
+    if (key == GLFW_KEY_C)
+        pipelineKey.cullMode = pipelineKey.cullMode == VK_CULL_MODE_BACK_BIT ? VK_CULL_MODE_NONE
+                             : pipelineKey.cullMode == VK_CULL_MODE_NONE ? VK_CULL_MODE_FRONT_BIT
+                             : VK_CULL_MODE_BACK_BIT;
+    if (key == GLFW_KEY_T)
+        pipelineKey.features.textureSampling = !pipelineKey.features.textureSampling;
+    if (key == GLFW_KEY_A)
+        pipelineKey.features.alphaTest = !pipelineKey.features.alphaTest;
+}
+
 void HelloTriangleApplication::initWindow()
 {
     glfwInit();
@@ -123,6 +306,7 @@ void HelloTriangleApplication::initWindow()
     glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
     window = glfwCreateWindow(WIDTH, HEIGHT, "31_Vulkan_Window", nullptr, nullptr);
     glfwSetFramebufferSizeCallback(window, framebufferResizeCallback);
+    glfwSetKeyCallback(window, keyCallback);
 }
 
 void HelloTriangleApplication::createInstance()
@@ -138,7 +322,7 @@ void HelloTriangleApplication::createInstance()
     appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
     appInfo.pEngineName = "No Engine";
     appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-    appInfo.apiVersion = VK_API_VERSION_1_0;
+    appInfo.apiVersion = GpuTimelineMgr::chooseInstanceApiVersion();
 
     const auto extensions = ExtensionsMgr::getRequiredExtensions();
 
@@ -159,7 +343,8 @@ void HelloTriangleApplication::createInstance()
     }
 
     ExtensionsMgr::checkAvailableExtensions(createInfo);
-    ExtensionsMgr::checkRequiredGlfwExtensions();
+    if (!AppOptions::headless)
+        ExtensionsMgr::checkRequiredGlfwExtensions();
 }
 
 void HelloTriangleApplication::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex)
@@ -186,9 +371,12 @@ void HelloTriangleApplication::recordCommandBuffer(VkCommandBuffer commandBuffer
     clearValues[1].depthStencil = {1.0f, 0};
     renderPassInfo.clearValueCount = clearValues.size();
     renderPassInfo.pClearValues = clearValues.data();
+    CullingMgr::recordCulling(commandBuffer, currentFrame, VertexDataMgr::modelMesh, UniformBufferMgr::viewProjection);
+
+    GpuProfiler::beginFrameScope(commandBuffer, currentFrame);
     vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, GraphicsPipelineMgr::graphicsPipeline);
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, PipelineLibrary::getPipeline(GraphicsPipelineMgr::pipelineKey));
     VkViewport viewport;
     viewport.x = 0.0f;
     viewport.y = 0.0f;
@@ -204,19 +392,14 @@ void HelloTriangleApplication::recordCommandBuffer(VkCommandBuffer commandBuffer
 
     vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
-    const VkBuffer vertexBuffers[] = {VertexDataMgr::vertexBuffer};
-    constexpr VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-    vkCmdBindIndexBuffer(commandBuffer, VertexDataMgr::indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-
     vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                             GraphicsPipelineMgr::pipelineLayout, 0, 1,
                             &DescriptorMgr::descriptorSets[currentFrame], 0, nullptr);
 
-    vkCmdDrawIndexed(commandBuffer,
-                     static_cast<uint32_t>(VertexDataMgr::indices.size()), 1, 0, 0, 0);
+    CullingMgr::drawVisibleInstances(commandBuffer, currentFrame, VertexDataMgr::modelMesh);
 
     vkCmdEndRenderPass(commandBuffer);
+    GpuProfiler::endFrameScope(commandBuffer, currentFrame);
 
     if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
     {
@@ -226,61 +409,69 @@ void HelloTriangleApplication::recordCommandBuffer(VkCommandBuffer commandBuffer
 
 void HelloTriangleApplication::drawFrame()
 {
-    vkWaitForFences(LogicalDevicesMgr::device, 1, &SyncObjectsMgr::inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+    {
+        ScopedCpuTimer timer(FrameStage::FenceWait);
+        GpuTimelineMgr::waitForValue(SyncObjectsMgr::frameTimelineValues[currentFrame]);
+    }
+    GpuProfiler::collectFrame(currentFrame);
+    DeletionQueueMgr::collect();
 
     uint32_t imageIndex = 0;
-    VkResult result = vkAcquireNextImageKHR(LogicalDevicesMgr::device, SwapChainMgr::swapChain, UINT64_MAX,
-                                            SyncObjectsMgr::imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE,
-                                            &imageIndex);
-    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+    VkResult result;
+    {
+        ScopedCpuTimer timer(FrameStage::Acquire);
+        result = SwapChainMgr::acquireNextImage(SyncObjectsMgr::imageAvailableSemaphores[currentFrame], imageIndex);
+    }
+    // A suboptimal image has been acquired and its semaphore will signal, so it is still rendered and the swapchain is
+    // recreated after presenting it
+    if (result == VK_ERROR_OUT_OF_DATE_KHR)
     {
         SwapChainMgr::recreateSwapChain();
         return;
     }
-    if (result != VK_SUCCESS)
+    if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
     {
         throw std::runtime_error("failed to acquire swap chain image!");
     }
 
-    UniformBufferMgr::updateUniformBuffer(currentFrame);
-
-    vkResetFences(LogicalDevicesMgr::device, 1, &SyncObjectsMgr::inFlightFences[currentFrame]);
+    {
+        ScopedCpuTimer timer(FrameStage::UpdateUniforms);
+        UniformBufferMgr::updateUniformBuffer(currentFrame);
+        InstanceBufferMgr::updateInstanceBuffer(currentFrame);
+    }
 
-    vkResetCommandBuffer(CommandBuffersMgr::commandBuffers[currentFrame], /*VkCommandBufferResetFlagBits*/ 0);
-    recordCommandBuffer(CommandBuffersMgr::commandBuffers[currentFrame], imageIndex);
+    {
+        ScopedCpuTimer timer(FrameStage::Record);
+        vkResetCommandBuffer(CommandBuffersMgr::commandBuffers[currentFrame], /*VkCommandBufferResetFlagBits*/ 0);
+        recordCommandBuffer(CommandBuffersMgr::commandBuffers[currentFrame], imageIndex);
+    }
 
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
     const VkSemaphore waitSemaphores[] = {SyncObjectsMgr::imageAvailableSemaphores[currentFrame]};
     constexpr VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
+    // Offscreen images are neither acquired nor presented, so there is nothing to wait on or signal
+    const bool presenting = SurfaceMgr::hasSurface();
+    submitInfo.waitSemaphoreCount = presenting ? 1 : 0;
     submitInfo.pWaitSemaphores = waitSemaphores;
     submitInfo.pWaitDstStageMask = waitStages;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &CommandBuffersMgr::commandBuffers[currentFrame];
 
     const VkSemaphore signalSemaphores[] = {SyncObjectsMgr::renderFinishedSemaphores[currentFrame]};
-    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.signalSemaphoreCount = presenting ? 1 : 0;
     submitInfo.pSignalSemaphores = signalSemaphores;
 
-    if (vkQueueSubmit(LogicalDevicesMgr::graphicsQueue, 1, &submitInfo, SyncObjectsMgr::inFlightFences[currentFrame]) != VK_SUCCESS)
     {
-        throw std::runtime_error("failed to submit draw command buffer!");
+        ScopedCpuTimer timer(FrameStage::Submit);
+        SyncObjectsMgr::frameTimelineValues[currentFrame] = GpuTimelineMgr::submit(LogicalDevicesMgr::graphicsQueue, submitInfo);
     }
 
-    VkPresentInfoKHR presentInfo{};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
-
-    const VkSwapchainKHR swapChains[] = {SwapChainMgr::swapChain};
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
-
-    result = vkQueuePresentKHR(LogicalDevicesMgr::graphicsQueue, &presentInfo);
+    {
+        ScopedCpuTimer timer(FrameStage::Present);
+        result = SwapChainMgr::present(signalSemaphores[0], imageIndex);
+    }
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized)
     {
         framebufferResized = false;
@@ -291,5 +482,5 @@ void HelloTriangleApplication::drawFrame()
         throw std::runtime_error("failed to present!");
     }
 
-    currentFrame = (currentFrame + 1) % GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT;
+    currentFrame = (currentFrame + 1) % GraphicsPipelineMgr::framesInFlight;
 }
\ No newline at end of file
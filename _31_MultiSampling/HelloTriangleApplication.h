@@ -8,9 +8,13 @@ public:
     void run();
     static GLFWwindow* window;
 
+    // Waits for the GPU to go idle, then rebuilds every per frame resource for the new count
+    static void setFramesInFlight(uint32_t count);
+
 private:
     void initVulkan();
     void initWindow();
+    void prebuildPipelines();
     void mainLoop();
     void cleanup();
 
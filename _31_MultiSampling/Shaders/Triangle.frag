@@ -2,6 +2,11 @@
 
 #extension GL_ARB_separate_shader_objects: enable
 
+// Specialization constants, see ShaderFeatures
+layout (constant_id = 0) const bool TEXTURE_SAMPLING = true;
+layout (constant_id = 2) const bool ALPHA_TEST = false;
+layout (constant_id = 4) const float ALPHA_CUTOFF = 0.5;
+
 layout (location = 0) in vec3 fragColor;
 layout (location = 1) in vec2 fragTexCoord;
 
@@ -11,10 +16,10 @@ layout (binding = 1) uniform sampler2D texSampler;
 
 void main()
 {
-    //    outColor = vec4(fragTexCoord, 0.0, 1.0);
-    outColor = texture(texSampler, fragTexCoord);
+    vec4 color = vec4(fragColor, 1.0);
+    if (TEXTURE_SAMPLING)
+        color *= texture(texSampler, fragTexCoord);
+    if (ALPHA_TEST && color.a < ALPHA_CUTOFF)
+        discard;
+    outColor = color;
 }
-
-
-
-
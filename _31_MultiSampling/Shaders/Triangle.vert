@@ -1,24 +1,35 @@
 #version 450
 
+// Specialization constants, see ShaderFeatures
+layout (constant_id = 1) const bool VERTEX_COLOR = false;
+layout (constant_id = 3) const bool QUANTIZED_DECODE = true;
+
 layout(binding = 0) uniform UniformBufferObject {
-    mat4 model;
     mat4 view;
     mat4 proj;
 } ubo;
 
+// Quantization of the mesh being drawn, see MeshPushConstants
+layout(push_constant) uniform MeshConstants {
+    vec4 positionScale;
+    vec4 positionOffset;
+    vec4 texCoordScaleOffset;
+} mesh;
+
+// Quantized layouts store both relative to the mesh bounds, normalized formats arrive here in [0, 1]
 layout (location = 0) in vec3 inPosition;
+// Only meaningful with VERTEX_COLOR, layouts without colors bind something else here
 layout (location = 1) in vec3 inColor;
 layout (location = 2) in vec2 inTexCoord;
+// Per instance, occupies locations 3 to 6
+layout (location = 3) in mat4 inModel;
 
 layout (location = 0) out vec3 fragColor;
 layout (location = 1) out vec2 fragTexCoord;
 
 void main() {
-    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(inPosition, 1.0);
-    fragColor = inColor;
-    fragTexCoord = inTexCoord;
+    vec3 position = QUANTIZED_DECODE ? inPosition * mesh.positionScale.xyz + mesh.positionOffset.xyz : inPosition;
+    gl_Position = ubo.proj * ubo.view * inModel * vec4(position, 1.0);
+    fragColor = VERTEX_COLOR ? inColor : vec3(1.0);
+    fragTexCoord = QUANTIZED_DECODE ? inTexCoord * mesh.texCoordScaleOffset.xy + mesh.texCoordScaleOffset.zw : inTexCoord;
 }
-
-
-
-
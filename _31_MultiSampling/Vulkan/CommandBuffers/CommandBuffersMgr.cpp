@@ -2,13 +2,19 @@
 
 #include <stdexcept>
 
+#include "../GpuTimelineMgr.h"
 #include "../LogicalDevicesMgr.h"
 #include "../GraphicPipeline/GraphicsPipelineMgr.h"
 #include "../QueueFamily/QueueFamilyMgr.h"
 #include "../QueueFamily/QueueFamilyIndices.h"
+#include "../Memory/StagingBufferMgr.h"
 
 VkCommandPool CommandBuffersMgr::commandPool = VK_NULL_HANDLE;
+VkCommandPool CommandBuffersMgr::transferCommandPool = VK_NULL_HANDLE;
 std::vector<VkCommandBuffer> CommandBuffersMgr::commandBuffers = {};
+std::deque<CommandBuffersMgr::PendingSubmission> CommandBuffersMgr::pendingSubmissions{};
+std::vector<VkSemaphore> CommandBuffersMgr::freeSemaphores{};
+UploadCommandBuffers CommandBuffersMgr::uploadCommandBuffers{};
 
 void CommandBuffersMgr::createCommandPool()
 {
@@ -22,16 +28,34 @@ void CommandBuffersMgr::createCommandPool()
     {
         throw std::runtime_error("failed to create command pool!");
     }
+
+    transferCommandPool = commandPool;
+    if (LogicalDevicesMgr::hasDedicatedTransferQueue())
+    {
+        poolInfo.queueFamilyIndex = LogicalDevicesMgr::transferQueueFamily;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        if (vkCreateCommandPool(LogicalDevicesMgr::device, &poolInfo, nullptr, &transferCommandPool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create transfer command pool!");
+        }
+    }
 }
 
 void CommandBuffersMgr::destroyCommandPool()
 {
+    waitForSerial(getLastSubmittedSerial());
+    for (VkSemaphore semaphore : freeSemaphores)
+        vkDestroySemaphore(LogicalDevicesMgr::device, semaphore, nullptr);
+    freeSemaphores.clear();
+
+    if (transferCommandPool != commandPool)
+        vkDestroyCommandPool(LogicalDevicesMgr::device, transferCommandPool, nullptr);
     vkDestroyCommandPool(LogicalDevicesMgr::device, commandPool, nullptr);
 }
 
 void CommandBuffersMgr::createCommandBuffers()
 {
-    commandBuffers.resize(GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT);
+    commandBuffers.resize(GraphicsPipelineMgr::framesInFlight);
     VkCommandBufferAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocInfo.commandPool = commandPool;
@@ -44,11 +68,65 @@ void CommandBuffersMgr::createCommandBuffers()
     }
 }
 
+void CommandBuffersMgr::destroyCommandBuffers()
+{
+    vkFreeCommandBuffers(LogicalDevicesMgr::device, commandPool, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+    commandBuffers.clear();
+}
+
 VkCommandBuffer CommandBuffersMgr::beginSingleTimeCommands()
+{
+    return allocateAndBegin(commandPool);
+}
+
+void CommandBuffersMgr::endSingleTimeCommands(VkCommandBuffer commandBuffer)
+{
+    // Only this submission is waited on, work submitted before it keeps running
+    waitForSerial(submit(commandBuffer));
+}
+
+UploadCommandBuffers CommandBuffersMgr::beginUploadBatch()
+{
+    if (uploadCommandBuffers.graphics == VK_NULL_HANDLE)
+    {
+        uploadCommandBuffers.graphics = allocateAndBegin(commandPool);
+        uploadCommandBuffers.transfer = LogicalDevicesMgr::hasDedicatedTransferQueue()
+                                            ? allocateAndBegin(transferCommandPool)
+                                            : uploadCommandBuffers.graphics;
+    }
+
+    return uploadCommandBuffers;
+}
+
+UploadToken CommandBuffersMgr::submitUploadBatch()
+{
+    if (uploadCommandBuffers.graphics == VK_NULL_HANDLE)
+        return {getLastSubmittedSerial()};
+
+    const bool separateTransfer = uploadCommandBuffers.transfer != uploadCommandBuffers.graphics;
+    UploadToken token{submit(uploadCommandBuffers.graphics, separateTransfer ? uploadCommandBuffers.transfer : VK_NULL_HANDLE)};
+    uploadCommandBuffers = {};
+
+    // Everything staged for this batch is read by the submission that just went out
+    StagingBufferMgr::retire();
+    return token;
+}
+
+bool CommandBuffersMgr::isUploadComplete(UploadToken token)
+{
+    return pollCompletedSerial() >= token.serial;
+}
+
+void CommandBuffersMgr::waitForUpload(UploadToken token)
+{
+    waitForSerial(token.serial);
+}
+
+VkCommandBuffer CommandBuffersMgr::allocateAndBegin(VkCommandPool pool)
 {
     VkCommandBufferAllocateInfo allocInfo = {};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.commandPool = commandPool;
+    allocInfo.commandPool = pool;
     allocInfo.commandBufferCount = 1;
 
     VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
@@ -63,18 +141,97 @@ VkCommandBuffer CommandBuffersMgr::beginSingleTimeCommands()
     return commandBuffer;
 }
 
-void CommandBuffersMgr::endSingleTimeCommands(VkCommandBuffer commandBuffer)
+uint64_t CommandBuffersMgr::submit(VkCommandBuffer commandBuffer, VkCommandBuffer transferCommandBuffer)
 {
+    VkSemaphore transferSemaphore = VK_NULL_HANDLE;
+    if (transferCommandBuffer != VK_NULL_HANDLE)
+    {
+        vkEndCommandBuffer(transferCommandBuffer);
+        transferSemaphore = acquireSemaphore();
+
+        VkSubmitInfo transferSubmitInfo = {};
+        transferSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        transferSubmitInfo.commandBufferCount = 1;
+        transferSubmitInfo.pCommandBuffers = &transferCommandBuffer;
+        transferSubmitInfo.signalSemaphoreCount = 1;
+        transferSubmitInfo.pSignalSemaphores = &transferSemaphore;
+
+        if (vkQueueSubmit(LogicalDevicesMgr::transferQueue, 1, &transferSubmitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to submit transfer command buffer!");
+        }
+    }
+
     vkEndCommandBuffer(commandBuffer);
 
+    // The graphics half starts with the ownership acquires, which must not run before the transfer queue released the resources
+    constexpr VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
     VkSubmitInfo submitInfo = {};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffer;
+    if (transferSemaphore != VK_NULL_HANDLE)
+    {
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &transferSemaphore;
+        submitInfo.pWaitDstStageMask = &waitStage;
+    }
+
+    // The graphics submission waits for the transfer one, so its timeline value covers both. Command buffers are freed once it
+    // has been reached
+    const uint64_t serial = GpuTimelineMgr::submit(LogicalDevicesMgr::graphicsQueue, submitInfo);
+    pendingSubmissions.push_back({serial, commandBuffer, transferCommandBuffer, transferSemaphore});
+    return serial;
+}
+
+VkSemaphore CommandBuffersMgr::acquireSemaphore()
+{
+    if (!freeSemaphores.empty())
+    {
+        VkSemaphore semaphore = freeSemaphores.back();
+        freeSemaphores.pop_back();
+        return semaphore;
+    }
 
-    vkQueueSubmit(LogicalDevicesMgr::graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(LogicalDevicesMgr::graphicsQueue);
-    vkFreeCommandBuffers(LogicalDevicesMgr::device, commandPool, 1, &commandBuffer);
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    if (vkCreateSemaphore(LogicalDevicesMgr::device, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create transfer semaphore!");
+    }
+    return semaphore;
+}
+
+uint64_t CommandBuffersMgr::getLastSubmittedSerial()
+{
+    return GpuTimelineMgr::getLastSubmittedValue();
+}
+
+uint64_t CommandBuffersMgr::pollCompletedSerial()
+{
+    const uint64_t completedSerial = GpuTimelineMgr::getCompletedValue();
+    while (!pendingSubmissions.empty() && pendingSubmissions.front().serial <= completedSerial)
+    {
+        const PendingSubmission& submission = pendingSubmissions.front();
+        vkFreeCommandBuffers(LogicalDevicesMgr::device, commandPool, 1, &submission.commandBuffer);
+        if (submission.transferCommandBuffer != VK_NULL_HANDLE)
+        {
+            vkFreeCommandBuffers(LogicalDevicesMgr::device, transferCommandPool, 1, &submission.transferCommandBuffer);
+            freeSemaphores.push_back(submission.transferSemaphore);
+        }
+        pendingSubmissions.pop_front();
+    }
+
+    return completedSerial;
+}
+
+void CommandBuffersMgr::waitForSerial(uint64_t serial)
+{
+    GpuTimelineMgr::waitForValue(serial);
+    pollCompletedSerial();
 }
 
 
@@ -1,20 +1,66 @@
 #pragma once
 #include <vulkan/vulkan_core.h>
 
+#include <deque>
 #include <vector>
 
+// Identifies one submitted upload batch, it can be polled or waited on instead of draining the whole queue
+struct UploadToken
+{
+    uint64_t serial = 0;
+};
+
+// Copies go to the transfer queue, ownership acquires and graphics only work such as blits go to the graphics queue.
+// Both point to the same command buffer when the device has no dedicated transfer family.
+struct UploadCommandBuffers
+{
+    VkCommandBuffer transfer = VK_NULL_HANDLE;
+    VkCommandBuffer graphics = VK_NULL_HANDLE;
+};
+
 class CommandBuffersMgr
 {
 public:
     static void createCommandPool();
     static void destroyCommandPool();
     static VkCommandPool commandPool;
+    static VkCommandPool transferCommandPool;
 
     static VkCommandBuffer beginSingleTimeCommands();
     static void endSingleTimeCommands(VkCommandBuffer commandBuffer);
 
+    // Uploads record into one shared command buffer until the batch is submitted, beginUploadBatch opens it on first use
+    static UploadCommandBuffers beginUploadBatch();
+    static UploadToken submitUploadBatch();
+    static bool isUploadComplete(UploadToken token);
+    static void waitForUpload(UploadToken token);
+
+    // Serials are GpuTimelineMgr values shared with the frame submissions, resources used by a submission can be reused once
+    // its serial has completed
+    static uint64_t getLastSubmittedSerial();
+    static uint64_t pollCompletedSerial();
+    static void waitForSerial(uint64_t serial);
+
     static void createCommandBuffers();
+    static void destroyCommandBuffers();
     static std::vector<VkCommandBuffer> commandBuffers;
+
+private:
+    struct PendingSubmission
+    {
+        uint64_t serial;
+        VkCommandBuffer commandBuffer;
+        VkCommandBuffer transferCommandBuffer;
+        VkSemaphore transferSemaphore;
+    };
+
+    static VkCommandBuffer allocateAndBegin(VkCommandPool pool);
+    static uint64_t submit(VkCommandBuffer commandBuffer, VkCommandBuffer transferCommandBuffer = VK_NULL_HANDLE);
+    static VkSemaphore acquireSemaphore();
+
+    static std::deque<PendingSubmission> pendingSubmissions;
+    static std::vector<VkSemaphore> freeSemaphores;
+    static UploadCommandBuffers uploadCommandBuffers;
 };
 
 
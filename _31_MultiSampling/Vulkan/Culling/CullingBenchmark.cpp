@@ -0,0 +1,89 @@
+#include "CullingBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "FrustumCuller.h"
+#include "../Utils/ThreadPool.h"
+
+namespace
+{
+constexpr int ITERATIONS = 15;
+constexpr float WORLD_EXTENT = 500.0f;
+
+struct BenchmarkCase
+{
+    const char* name;
+    CullKernel kernel;
+    bool threaded;
+};
+}
+
+void CullingBenchmark::run(uint32_t objectCount)
+{
+    // Fixed seed, so every run and every kernel sees the same scene
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> position(-WORLD_EXTENT, WORLD_EXTENT);
+    std::uniform_real_distribution<float> halfExtent(0.1f, 4.0f);
+
+    FrustumCuller culler;
+    culler.reserve(objectCount);
+    for (uint32_t object = 0; object < objectCount; ++object)
+    {
+        const glm::vec3 center(position(random), position(random), position(random));
+        const glm::vec3 extent(halfExtent(random), halfExtent(random), halfExtent(random));
+        culler.addObject(center - extent, center + extent);
+    }
+
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.2f, 0.5f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, WORLD_EXTENT);
+    projection[1][1] *= -1;
+    const Frustum frustum = Frustum::fromViewProjection(projection * view);
+
+    ThreadPool& pool = ThreadPool::getShared();
+    std::vector<BenchmarkCase> cases = {{"scalar", CullKernel::Scalar, false}, {"sse", CullKernel::Sse, false}};
+    if (FrustumCuller::isAvxSupported())
+        cases.push_back({"avx", CullKernel::Avx, false});
+    cases.push_back({"auto + pool", CullKernel::Auto, true});
+
+    std::cout << "culling " << objectCount << " objects, " << pool.getThreadCount() << " worker threads, avx "
+        << (FrustumCuller::isAvxSupported() ? "on" : "off") << '\n';
+
+    // The first case is the reference, an empty visible list is a valid result so it cannot mark "not set yet"
+    bool haveReference = false;
+    std::vector<uint32_t> reference;
+    std::vector<uint32_t> visible;
+    for (const auto& benchmarkCase : cases)
+    {
+        std::vector<double> milliseconds;
+        for (int iteration = 0; iteration < ITERATIONS; ++iteration)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            culler.cull(frustum, visible, benchmarkCase.threaded ? &pool : nullptr, benchmarkCase.kernel);
+            milliseconds.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(milliseconds.begin(), milliseconds.end());
+
+        // Every kernel sums the plane distances in the same order, so the lists have to match exactly
+        if (!haveReference)
+        {
+            reference = visible;
+            haveReference = true;
+        }
+        else if (visible != reference)
+            throw std::runtime_error(std::string("culling kernel ") + benchmarkCase.name + " disagrees with the scalar kernel!");
+
+        std::cout << std::left << std::setw(12) << benchmarkCase.name << std::right << std::fixed << std::setprecision(3)
+            << " median " << std::setw(8) << milliseconds[ITERATIONS / 2] << " ms  min " << std::setw(8)
+            << milliseconds.front() << " ms  visible " << visible.size() << '\n';
+    }
+    std::cout << std::defaultfloat;
+}
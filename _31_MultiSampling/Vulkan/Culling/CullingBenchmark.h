@@ -0,0 +1,9 @@
+#pragma once
+#include <cstdint>
+
+// Times FrustumCuller on randomly placed objects with every kernel, single threaded and on the shared thread pool
+class CullingBenchmark
+{
+public:
+    static void run(uint32_t objectCount);
+};
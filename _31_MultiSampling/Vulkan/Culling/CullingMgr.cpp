@@ -0,0 +1,220 @@
+#include "CullingMgr.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <stdexcept>
+
+#include "FrustumCuller.h"
+#include "../LogicalDevicesMgr.h"
+#include "../GraphicPipeline/GraphicsPipelineMgr.h"
+#include "../GraphicPipeline/PipelineCacheMgr.h"
+#include "../GraphicPipeline/Shaders/ShaderRegistry.h"
+#include "../Instancing/InstanceBufferMgr.h"
+#include "../Memory/MemoryAllocatorMgr.h"
+#include "../Utils/BufferHelper.h"
+#include "../Vertex/GeometryPoolMgr.h"
+
+uint32_t CullingMgr::maxDrawsPerMesh = 64;
+VkDescriptorSetLayout CullingMgr::descriptorSetLayout = VK_NULL_HANDLE;
+VkPipelineLayout CullingMgr::pipelineLayout = VK_NULL_HANDLE;
+VkPipeline CullingMgr::pipeline = VK_NULL_HANDLE;
+VkDescriptorPool CullingMgr::descriptorPool = VK_NULL_HANDLE;
+std::vector<VkDescriptorSet> CullingMgr::descriptorSets{};
+std::vector<VkBuffer> CullingMgr::visibleInstanceBuffers{};
+std::vector<MemoryAllocation> CullingMgr::visibleInstanceBuffersMemory{};
+std::vector<VkBuffer> CullingMgr::drawCommandBuffers{};
+std::vector<MemoryAllocation> CullingMgr::drawCommandBuffersMemory{};
+
+namespace
+{
+constexpr uint32_t WORKGROUP_SIZE = 64;
+}
+
+void CullingMgr::createCullingPipeline(const std::string& compFileName)
+{
+    std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
+    for (uint32_t binding = 0; binding < bindings.size(); ++binding)
+    {
+        bindings[binding].binding = binding;
+        bindings[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[binding].descriptorCount = 1;
+        bindings[binding].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+    if (vkCreateDescriptorSetLayout(LogicalDevicesMgr::device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS)
+        throw std::runtime_error("failed to create culling descriptor set layout!");
+
+    const VkPushConstantRange pushConstantRange = {VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants)};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+    if (vkCreatePipelineLayout(LogicalDevicesMgr::device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+        throw std::runtime_error("failed to create culling pipeline layout!");
+
+    VkShaderModule compShaderModule = ShaderRegistry::getShaderModule(compFileName);
+
+    VkComputePipelineCreateInfo pipelineCreateInfo{};
+    pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineCreateInfo.stage.module = compShaderModule;
+    pipelineCreateInfo.stage.pName = "main";
+    pipelineCreateInfo.layout = pipelineLayout;
+
+    const VkResult result = vkCreateComputePipelines(LogicalDevicesMgr::device, PipelineCacheMgr::pipelineCache, 1, &pipelineCreateInfo, nullptr, &pipeline);
+    if (result != VK_SUCCESS)
+        throw std::runtime_error("failed to create culling pipeline!");
+}
+
+void CullingMgr::destroyCullingPipeline()
+{
+    vkDestroyPipeline(LogicalDevicesMgr::device, pipeline, nullptr);
+    vkDestroyPipelineLayout(LogicalDevicesMgr::device, pipelineLayout, nullptr);
+    vkDestroyDescriptorSetLayout(LogicalDevicesMgr::device, descriptorSetLayout, nullptr);
+}
+
+void CullingMgr::createCullingResources()
+{
+    const uint32_t framesInFlight = GraphicsPipelineMgr::framesInFlight;
+    visibleInstanceBuffers.resize(framesInFlight);
+    visibleInstanceBuffersMemory.resize(framesInFlight);
+    drawCommandBuffers.resize(framesInFlight);
+    drawCommandBuffersMemory.resize(framesInFlight);
+
+    for (uint32_t i = 0; i < framesInFlight; ++i)
+    {
+        BufferHelper::createBuffer(sizeof(InstanceData) * InstanceBufferMgr::instanceCount,
+                                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, visibleInstanceBuffers[i], visibleInstanceBuffersMemory[i]);
+        BufferHelper::createBuffer(sizeof(VkDrawIndexedIndirectCommand) * maxDrawsPerMesh,
+                                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, drawCommandBuffers[i], drawCommandBuffersMemory[i]);
+    }
+
+    createDescriptorSets();
+}
+
+void CullingMgr::destroyCullingResources()
+{
+    vkDestroyDescriptorPool(LogicalDevicesMgr::device, descriptorPool, nullptr);
+    descriptorSets.clear();
+
+    for (size_t i = 0; i < visibleInstanceBuffers.size(); ++i)
+    {
+        vkDestroyBuffer(LogicalDevicesMgr::device, visibleInstanceBuffers[i], nullptr);
+        MemoryAllocatorMgr::freeMemory(visibleInstanceBuffersMemory[i]);
+        vkDestroyBuffer(LogicalDevicesMgr::device, drawCommandBuffers[i], nullptr);
+        MemoryAllocatorMgr::freeMemory(drawCommandBuffersMemory[i]);
+    }
+    visibleInstanceBuffers.clear();
+    visibleInstanceBuffersMemory.clear();
+    drawCommandBuffers.clear();
+    drawCommandBuffersMemory.clear();
+}
+
+void CullingMgr::createDescriptorSets()
+{
+    const uint32_t framesInFlight = GraphicsPipelineMgr::framesInFlight;
+
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSize.descriptorCount = 3 * framesInFlight;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.maxSets = framesInFlight;
+    if (vkCreateDescriptorPool(LogicalDevicesMgr::device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
+        throw std::runtime_error("failed to create culling descriptor pool!");
+
+    descriptorSets.resize(framesInFlight);
+    const std::vector layouts(framesInFlight, descriptorSetLayout);
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = framesInFlight;
+    allocInfo.pSetLayouts = layouts.data();
+    if (vkAllocateDescriptorSets(LogicalDevicesMgr::device, &allocInfo, descriptorSets.data()) != VK_SUCCESS)
+        throw std::runtime_error("failed to allocate culling descriptor sets!");
+
+    for (uint32_t i = 0; i < framesInFlight; ++i)
+    {
+        const std::array<VkDescriptorBufferInfo, 3> bufferInfos = {
+            VkDescriptorBufferInfo{InstanceBufferMgr::instanceBuffers[i], 0, VK_WHOLE_SIZE},
+            VkDescriptorBufferInfo{visibleInstanceBuffers[i], 0, VK_WHOLE_SIZE},
+            VkDescriptorBufferInfo{drawCommandBuffers[i], 0, VK_WHOLE_SIZE}};
+
+        std::array<VkWriteDescriptorSet, 3> writeDescriptorSets{};
+        for (uint32_t binding = 0; binding < writeDescriptorSets.size(); ++binding)
+        {
+            writeDescriptorSets[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writeDescriptorSets[binding].dstSet = descriptorSets[i];
+            writeDescriptorSets[binding].dstBinding = binding;
+            writeDescriptorSets[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writeDescriptorSets[binding].descriptorCount = 1;
+            writeDescriptorSets[binding].pBufferInfo = &bufferInfos[binding];
+        }
+
+        vkUpdateDescriptorSets(LogicalDevicesMgr::device, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+    }
+}
+
+void CullingMgr::recordCulling(VkCommandBuffer commandBuffer, uint32_t currentFrame, uint32_t mesh, const glm::mat4& viewProjection)
+{
+    const PooledMesh& pooledMesh = GeometryPoolMgr::getMesh(mesh);
+    if (pooledMesh.draws.size() > maxDrawsPerMesh)
+        throw std::runtime_error("mesh has more draws than the culling pass can hold!");
+
+    // The commands are reset with zero instances, the compute pass counts the visible ones into them
+    std::vector<VkDrawIndexedIndirectCommand> drawCommands(pooledMesh.draws.size());
+    for (size_t draw = 0; draw < drawCommands.size(); ++draw)
+    {
+        drawCommands[draw].indexCount = pooledMesh.draws[draw].indexCount;
+        drawCommands[draw].instanceCount = 0;
+        drawCommands[draw].firstIndex = pooledMesh.draws[draw].firstIndex;
+        drawCommands[draw].vertexOffset = pooledMesh.draws[draw].vertexOffset;
+        drawCommands[draw].firstInstance = 0;
+    }
+    vkCmdUpdateBuffer(commandBuffer, drawCommandBuffers[currentFrame], 0, sizeof(VkDrawIndexedIndirectCommand) * drawCommands.size(),
+                      drawCommands.data());
+
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr,
+                         0, nullptr);
+
+    CullPushConstants pushConstants{};
+    const Frustum frustum = Frustum::fromViewProjection(viewProjection);
+    std::copy(std::begin(frustum.planes), std::end(frustum.planes), pushConstants.frustumPlanes);
+    pushConstants.boundingSphere = pooledMesh.boundingSphere;
+    pushConstants.instanceCount = InstanceBufferMgr::instanceCount;
+    pushConstants.drawCount = static_cast<uint32_t>(drawCommands.size());
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+    vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+    vkCmdDispatch(commandBuffer, (InstanceBufferMgr::instanceCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+void CullingMgr::drawVisibleInstances(VkCommandBuffer commandBuffer, uint32_t currentFrame, uint32_t mesh)
+{
+    constexpr VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 1, 1, &visibleInstanceBuffers[currentFrame], &offset);
+    GeometryPoolMgr::drawMeshIndirect(commandBuffer, GraphicsPipelineMgr::pipelineLayout, mesh, drawCommandBuffers[currentFrame], 0);
+}
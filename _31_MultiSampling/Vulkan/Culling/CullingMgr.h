@@ -0,0 +1,54 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../Memory/MemoryAllocation.h"
+
+// Matches the push constant block of Cull.comp
+struct CullPushConstants
+{
+    glm::vec4 frustumPlanes[6];
+    glm::vec4 boundingSphere;
+    uint32_t instanceCount;
+    uint32_t drawCount;
+};
+
+// Frustum culls the instances of a mesh on the GPU. A compute pass compacts the visible instances into a per frame buffer
+// and counts them into the instanceCount of the mesh's indirect draw commands, so recording the frame costs the same for
+// one instance or a hundred thousand.
+class CullingMgr
+{
+public:
+    static void createCullingPipeline(const std::string& compFileName);
+    static void destroyCullingPipeline();
+
+    // Per frame in flight and sized by the instance count, create after the instance buffers
+    static void createCullingResources();
+    static void destroyCullingResources();
+
+    // Records outside of a render pass, before drawVisibleInstances
+    static void recordCulling(VkCommandBuffer commandBuffer, uint32_t currentFrame, uint32_t mesh, const glm::mat4& viewProjection);
+    // Binds the visible instances to binding 1 and draws the mesh indirectly, inside the render pass
+    static void drawVisibleInstances(VkCommandBuffer commandBuffer, uint32_t currentFrame, uint32_t mesh);
+
+    // Indirect commands reserved per frame, a mesh split into more draws than this cannot be culled
+    static uint32_t maxDrawsPerMesh;
+
+private:
+    static void createDescriptorSets();
+
+    static VkDescriptorSetLayout descriptorSetLayout;
+    static VkPipelineLayout pipelineLayout;
+    static VkPipeline pipeline;
+    static VkDescriptorPool descriptorPool;
+    static std::vector<VkDescriptorSet> descriptorSets;
+
+    static std::vector<VkBuffer> visibleInstanceBuffers;
+    static std::vector<MemoryAllocation> visibleInstanceBuffersMemory;
+    static std::vector<VkBuffer> drawCommandBuffers;
+    static std::vector<MemoryAllocation> drawCommandBuffersMemory;
+};
@@ -0,0 +1,287 @@
+#include "FrustumCuller.h"
+
+#include <algorithm>
+
+#include "../Utils/ThreadPool.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define FRUSTUM_CULLER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+// MSVC compiles AVX intrinsics without /arch:AVX, the kernel is only called after the runtime check
+#define AVX_TARGET
+#else
+#include <cpuid.h>
+#define AVX_TARGET __attribute__((target("avx")))
+#endif
+#endif
+
+namespace
+{
+constexpr uint32_t CULL_GRAIN = 16384;
+
+#ifdef FRUSTUM_CULLER_X86
+// Appends begin + i for every set bit i of mask, lowest first
+void appendMask(uint32_t mask, uint32_t begin, std::vector<uint32_t>& visible)
+{
+    while (mask != 0)
+    {
+#ifdef _MSC_VER
+        unsigned long bit;
+        _BitScanForward(&bit, mask);
+#else
+        const uint32_t bit = static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+        visible.push_back(begin + bit);
+        mask &= mask - 1;
+    }
+}
+#endif
+}
+
+Frustum Frustum::fromViewProjection(const glm::mat4& viewProjection)
+{
+    const glm::mat4 rows = glm::transpose(viewProjection);
+
+    Frustum frustum;
+    frustum.planes[0] = rows[3] + rows[0];
+    frustum.planes[1] = rows[3] - rows[0];
+    frustum.planes[2] = rows[3] + rows[1];
+    frustum.planes[3] = rows[3] - rows[1];
+    frustum.planes[4] = rows[2];
+    frustum.planes[5] = rows[3] - rows[2];
+
+    for (auto& plane : frustum.planes)
+        plane /= glm::length(glm::vec3(plane));
+    return frustum;
+}
+
+void FrustumCuller::reserve(size_t objectCount)
+{
+    for (auto* field : {&centerX, &centerY, &centerZ, &radius, &minX, &minY, &minZ, &maxX, &maxY, &maxZ})
+        field->reserve(objectCount);
+}
+
+void FrustumCuller::clear()
+{
+    for (auto* field : {&centerX, &centerY, &centerZ, &radius, &minX, &minY, &minZ, &maxX, &maxY, &maxZ})
+        field->clear();
+}
+
+uint32_t FrustumCuller::addObject(const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+    const auto object = static_cast<uint32_t>(centerX.size());
+    for (auto* field : {&centerX, &centerY, &centerZ, &radius, &minX, &minY, &minZ, &maxX, &maxY, &maxZ})
+        field->push_back(0.0f);
+
+    setObject(object, boundsMin, boundsMax);
+    return object;
+}
+
+void FrustumCuller::setObject(uint32_t object, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+    const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    centerX[object] = center.x;
+    centerY[object] = center.y;
+    centerZ[object] = center.z;
+    radius[object] = glm::length(boundsMax - boundsMin) * 0.5f;
+    minX[object] = boundsMin.x;
+    minY[object] = boundsMin.y;
+    minZ[object] = boundsMin.z;
+    maxX[object] = boundsMax.x;
+    maxY[object] = boundsMax.y;
+    maxZ[object] = boundsMax.z;
+}
+
+void FrustumCuller::cull(const Frustum& frustum, std::vector<uint32_t>& visible, ThreadPool* pool, CullKernel kernel) const
+{
+    if (kernel == CullKernel::Auto)
+        kernel = isAvxSupported() ? CullKernel::Avx : CullKernel::Sse;
+    if (kernel == CullKernel::Avx && !isAvxSupported())
+        kernel = CullKernel::Sse;
+
+    visible.clear();
+    const auto objectCount = static_cast<uint32_t>(getObjectCount());
+    if (pool == nullptr || objectCount <= CULL_GRAIN)
+    {
+        cullRange(frustum, 0, objectCount, kernel, visible);
+        return;
+    }
+
+    // Every range fills its own list, concatenating them in range order keeps the indices ascending
+    std::vector<std::vector<uint32_t>> rangeVisible((objectCount + CULL_GRAIN - 1) / CULL_GRAIN);
+    pool->parallelFor(objectCount, CULL_GRAIN, [&](size_t begin, size_t end)
+    {
+        cullRange(frustum, static_cast<uint32_t>(begin), static_cast<uint32_t>(end), kernel, rangeVisible[begin / CULL_GRAIN]);
+    });
+
+    size_t visibleCount = 0;
+    for (const auto& range : rangeVisible)
+        visibleCount += range.size();
+    visible.reserve(visibleCount);
+    for (const auto& range : rangeVisible)
+        visible.insert(visible.end(), range.begin(), range.end());
+}
+
+bool FrustumCuller::isAvxSupported()
+{
+#ifdef FRUSTUM_CULLER_X86
+    static const bool supported = []()
+    {
+        // CPUID reports AVX, OSXSAVE reports that XGETBV may be used to ask whether the OS saves the YMM registers
+        uint32_t ecx = 0;
+#ifdef _MSC_VER
+        int registers[4];
+        __cpuid(registers, 1);
+        ecx = static_cast<uint32_t>(registers[2]);
+#else
+        uint32_t eax, ebx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return false;
+#endif
+        const bool osxsave = (ecx & (1u << 27)) != 0;
+        const bool avx = (ecx & (1u << 28)) != 0;
+        if (!osxsave || !avx)
+            return false;
+
+#ifdef _MSC_VER
+        const uint64_t xcr0 = _xgetbv(0);
+#else
+        uint32_t xcr0Low, xcr0High;
+        __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+        const uint64_t xcr0 = (static_cast<uint64_t>(xcr0High) << 32) | xcr0Low;
+#endif
+        return (xcr0 & 0x6) == 0x6;
+    }();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void FrustumCuller::cullRange(const Frustum& frustum, uint32_t begin, uint32_t end, CullKernel kernel, std::vector<uint32_t>& visible) const
+{
+#ifdef FRUSTUM_CULLER_X86
+    if (kernel == CullKernel::Avx)
+    {
+        cullRangeAvx(frustum, begin, end, visible);
+        return;
+    }
+    if (kernel == CullKernel::Sse)
+    {
+        cullRangeSse(frustum, begin, end, visible);
+        return;
+    }
+#endif
+    cullRangeScalar(frustum, begin, end, visible);
+}
+
+void FrustumCuller::cullRangeScalar(const Frustum& frustum, uint32_t begin, uint32_t end, std::vector<uint32_t>& visible) const
+{
+    for (uint32_t object = begin; object < end; ++object)
+    {
+        bool inside = true;
+        for (const auto& plane : frustum.planes)
+        {
+            // Summed as (xy) + (zw) like the SIMD kernels, float addition is not associative
+            const float sphereDistance = (plane.x * centerX[object] + plane.y * centerY[object]) +
+                (plane.z * centerZ[object] + plane.w);
+            // The box corner furthest along the plane normal
+            const float boxDistance = (plane.x * (plane.x > 0.0f ? maxX[object] : minX[object]) +
+                    plane.y * (plane.y > 0.0f ? maxY[object] : minY[object])) +
+                (plane.z * (plane.z > 0.0f ? maxZ[object] : minZ[object]) + plane.w);
+            inside &= sphereDistance >= -radius[object] && boxDistance >= 0.0f;
+        }
+
+        if (inside)
+            visible.push_back(object);
+    }
+}
+
+#ifdef FRUSTUM_CULLER_X86
+void FrustumCuller::cullRangeSse(const Frustum& frustum, uint32_t begin, uint32_t end, std::vector<uint32_t>& visible) const
+{
+    uint32_t object = begin;
+    for (; object + 4 <= end; object += 4)
+    {
+        const __m128 x = _mm_loadu_ps(&centerX[object]);
+        const __m128 y = _mm_loadu_ps(&centerY[object]);
+        const __m128 z = _mm_loadu_ps(&centerZ[object]);
+        const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&radius[object]));
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const auto& plane : frustum.planes)
+        {
+            const __m128 planeX = _mm_set1_ps(plane.x);
+            const __m128 planeY = _mm_set1_ps(plane.y);
+            const __m128 planeZ = _mm_set1_ps(plane.z);
+            const __m128 planeW = _mm_set1_ps(plane.w);
+
+            const __m128 sphereDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX, x), _mm_mul_ps(planeY, y)),
+                                                     _mm_add_ps(_mm_mul_ps(planeZ, z), planeW));
+
+            // The plane is the same for every lane, so picking the far corner is a scalar decision per axis
+            const __m128 cornerX = _mm_loadu_ps(plane.x > 0.0f ? &maxX[object] : &minX[object]);
+            const __m128 cornerY = _mm_loadu_ps(plane.y > 0.0f ? &maxY[object] : &minY[object]);
+            const __m128 cornerZ = _mm_loadu_ps(plane.z > 0.0f ? &maxZ[object] : &minZ[object]);
+            const __m128 boxDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX, cornerX), _mm_mul_ps(planeY, cornerY)),
+                                                  _mm_add_ps(_mm_mul_ps(planeZ, cornerZ), planeW));
+
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(sphereDistance, negativeRadius));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(boxDistance, _mm_setzero_ps()));
+        }
+
+        appendMask(static_cast<uint32_t>(_mm_movemask_ps(inside)), object, visible);
+    }
+
+    cullRangeScalar(frustum, object, end, visible);
+}
+
+AVX_TARGET void FrustumCuller::cullRangeAvx(const Frustum& frustum, uint32_t begin, uint32_t end, std::vector<uint32_t>& visible) const
+{
+    uint32_t object = begin;
+    for (; object + 8 <= end; object += 8)
+    {
+        const __m256 x = _mm256_loadu_ps(&centerX[object]);
+        const __m256 y = _mm256_loadu_ps(&centerY[object]);
+        const __m256 z = _mm256_loadu_ps(&centerZ[object]);
+        const __m256 negativeRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&radius[object]));
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const auto& plane : frustum.planes)
+        {
+            const __m256 planeX = _mm256_set1_ps(plane.x);
+            const __m256 planeY = _mm256_set1_ps(plane.y);
+            const __m256 planeZ = _mm256_set1_ps(plane.z);
+            const __m256 planeW = _mm256_set1_ps(plane.w);
+
+            const __m256 sphereDistance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(planeX, x), _mm256_mul_ps(planeY, y)),
+                                                        _mm256_add_ps(_mm256_mul_ps(planeZ, z), planeW));
+
+            const __m256 cornerX = _mm256_loadu_ps(plane.x > 0.0f ? &maxX[object] : &minX[object]);
+            const __m256 cornerY = _mm256_loadu_ps(plane.y > 0.0f ? &maxY[object] : &minY[object]);
+            const __m256 cornerZ = _mm256_loadu_ps(plane.z > 0.0f ? &maxZ[object] : &minZ[object]);
+            const __m256 boxDistance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(planeX, cornerX), _mm256_mul_ps(planeY, cornerY)),
+                                                     _mm256_add_ps(_mm256_mul_ps(planeZ, cornerZ), planeW));
+
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(sphereDistance, negativeRadius, _CMP_GE_OQ));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(boxDistance, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+
+        appendMask(static_cast<uint32_t>(_mm256_movemask_ps(inside)), object, visible);
+    }
+
+    cullRangeScalar(frustum, object, end, visible);
+}
+#else
+void FrustumCuller::cullRangeSse(const Frustum& frustum, uint32_t begin, uint32_t end, std::vector<uint32_t>& visible) const
+{
+    cullRangeScalar(frustum, begin, end, visible);
+}
+
+void FrustumCuller::cullRangeAvx(const Frustum& frustum, uint32_t begin, uint32_t end, std::vector<uint32_t>& visible) const
+{
+    cullRangeScalar(frustum, begin, end, visible);
+}
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class ThreadPool;
+
+// Six normalized planes whose xyz points into the frustum, a point p is inside when dot(xyz, p) + w >= 0 for all of them
+struct Frustum
+{
+    glm::vec4 planes[6];
+
+    // Gribb and Hartmann, for Vulkan clip space where 0 <= z <= w
+    static Frustum fromViewProjection(const glm::mat4& viewProjection);
+};
+
+enum class CullKernel
+{
+    Auto, // Widest kernel the CPU supports
+    Scalar,
+    Sse,  // 4 objects per iteration
+    Avx   // 8 objects per iteration, only used when the CPU and OS support AVX
+};
+
+// CPU frustum culling over world space bounds kept as structure of arrays, so a SIMD kernel loads the same field of 4 or 8
+// objects at once. Every object is first tested by its bounding sphere and then by its AABB, which rejects more of the
+// objects near the frustum corners.
+class FrustumCuller
+{
+public:
+    void reserve(size_t objectCount);
+    void clear();
+    // Returns the index of the object, its bounding sphere encloses the box
+    uint32_t addObject(const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+    void setObject(uint32_t object, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+    size_t getObjectCount() const { return centerX.size(); }
+
+    // Replaces visible with the ascending indices of every object that intersects the frustum. Ranges of objects are spread
+    // over pool when it is not null.
+    void cull(const Frustum& frustum, std::vector<uint32_t>& visible, ThreadPool* pool, CullKernel kernel = CullKernel::Auto) const;
+
+    static bool isAvxSupported();
+
+private:
+    void cullRange(const Frustum& frustum, uint32_t begin, uint32_t end, CullKernel kernel, std::vector<uint32_t>& visible) const;
+    void cullRangeScalar(const Frustum& frustum, uint32_t begin, uint32_t end, std::vector<uint32_t>& visible) const;
+    void cullRangeSse(const Frustum& frustum, uint32_t begin, uint32_t end, std::vector<uint32_t>& visible) const;
+    void cullRangeAvx(const Frustum& frustum, uint32_t begin, uint32_t end, std::vector<uint32_t>& visible) const;
+
+    std::vector<float> centerX, centerY, centerZ, radius;
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+};
@@ -0,0 +1,29 @@
+#include "DeletionQueueMgr.h"
+
+#include "GpuTimelineMgr.h"
+
+std::deque<DeletionQueueMgr::PendingDeletion> DeletionQueueMgr::pendingDeletions{};
+
+void DeletionQueueMgr::defer(std::function<void()> deleter)
+{
+    pendingDeletions.push_back({GpuTimelineMgr::getLastSubmittedValue(), std::move(deleter)});
+}
+
+void DeletionQueueMgr::collect()
+{
+    const uint64_t completedValue = GpuTimelineMgr::getCompletedValue();
+    while (!pendingDeletions.empty() && pendingDeletions.front().timelineValue <= completedValue)
+    {
+        pendingDeletions.front().deleter();
+        pendingDeletions.pop_front();
+    }
+}
+
+void DeletionQueueMgr::flush()
+{
+    if (pendingDeletions.empty())
+        return;
+
+    GpuTimelineMgr::waitForValue(pendingDeletions.back().timelineValue);
+    collect();
+}
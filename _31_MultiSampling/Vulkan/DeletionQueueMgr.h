@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+// Destroys objects that in-flight GPU work may still reference once the GPU timeline has passed the last submission that
+// could have used them, instead of waiting for the device to go idle.
+class DeletionQueueMgr
+{
+public:
+    // The deleter runs once everything submitted so far has completed
+    static void defer(std::function<void()> deleter);
+    // Runs every deleter whose timeline value has been reached, call it once per frame
+    static void collect();
+    // Waits for the GPU and runs every remaining deleter
+    static void flush();
+
+private:
+    struct PendingDeletion
+    {
+        uint64_t timelineValue;
+        std::function<void()> deleter;
+    };
+
+    static std::deque<PendingDeletion> pendingDeletions;
+};
@@ -3,6 +3,7 @@
 #include <stdexcept>
 
 #include "LogicalDevicesMgr.h"
+#include "Memory/MemoryAllocatorMgr.h"
 #include "MsaaMgr.h"
 #include "PhysicalDevicesMgr.h"
 #include "SwapChain/SwapChainMgr.h"
@@ -10,7 +11,7 @@
 #include "Utils/ImageHelper.h"
 
 VkImage DepthBufferMgr::depthImage = VK_NULL_HANDLE;
-VkDeviceMemory DepthBufferMgr::depthImageMemory = VK_NULL_HANDLE;
+MemoryAllocation DepthBufferMgr::depthImageMemory{};
 VkImageView DepthBufferMgr::depthImageView = VK_NULL_HANDLE;
 
 void DepthBufferMgr::createDepthResources()
@@ -26,7 +27,7 @@ void DepthBufferMgr::destroyDepthResources()
 {
     vkDestroyImageView(LogicalDevicesMgr::device, depthImageView, nullptr);
     vkDestroyImage(LogicalDevicesMgr::device, depthImage, nullptr);
-    vkFreeMemory(LogicalDevicesMgr::device, depthImageMemory, nullptr);
+    MemoryAllocatorMgr::freeMemory(depthImageMemory);
 }
 
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "CommandBuffers/CommandBuffersMgr.h"
+#include "Memory/MemoryAllocation.h"
 
 class DepthBufferMgr
 {
@@ -8,7 +9,7 @@ public:
     static void destroyDepthResources();
     static VkFormat findDepthFormat();
     static VkImage depthImage;
-    static VkDeviceMemory depthImageMemory;
+    static MemoryAllocation depthImageMemory;
     static VkImageView depthImageView;
 
 private:
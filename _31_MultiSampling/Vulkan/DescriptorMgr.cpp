@@ -17,15 +17,15 @@ void DescriptorMgr::createDescriptorPool()
 {
     std::array<VkDescriptorPoolSize, 2> poolSizes{};
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[0].descriptorCount = static_cast<uint32_t>(GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT);
+    poolSizes[0].descriptorCount = GraphicsPipelineMgr::framesInFlight;
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = static_cast<uint32_t>(GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT);
+    poolSizes[1].descriptorCount = GraphicsPipelineMgr::framesInFlight;
 
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
     poolInfo.pPoolSizes = poolSizes.data();
-    poolInfo.maxSets = static_cast<uint32_t>(GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT); // Every frame will have its own descriptor set
+    poolInfo.maxSets = GraphicsPipelineMgr::framesInFlight; // Every frame will have its own descriptor set
 
     if (vkCreateDescriptorPool(LogicalDevicesMgr::device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
     {
@@ -40,13 +40,13 @@ void DescriptorMgr::destroyDescriptorPool()
 
 void DescriptorMgr::createDescriptorSets()
 {
-    descriptorSets.resize(GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT);
+    descriptorSets.resize(GraphicsPipelineMgr::framesInFlight);
 
-    const std::vector layouts(GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT, descriptorSetLayout);
+    const std::vector layouts(GraphicsPipelineMgr::framesInFlight, descriptorSetLayout);
     VkDescriptorSetAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocInfo.descriptorPool = descriptorPool;
-    allocInfo.descriptorSetCount = static_cast<uint32_t>(GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT);
+    allocInfo.descriptorSetCount = GraphicsPipelineMgr::framesInFlight;
     allocInfo.pSetLayouts = layouts.data();
 
     if (vkAllocateDescriptorSets(LogicalDevicesMgr::device, &allocInfo, descriptorSets.data()) != VK_SUCCESS)
@@ -54,7 +54,7 @@ void DescriptorMgr::createDescriptorSets()
         throw std::runtime_error("Failed to allocate descriptor sets!");
     }
 
-    for (size_t i = 0; i < GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT; ++i)
+    for (size_t i = 0; i < GraphicsPipelineMgr::framesInFlight; ++i)
     {
         VkDescriptorBufferInfo bufferInfo{};
         bufferInfo.buffer = UniformBufferMgr::uniformBuffers[i];
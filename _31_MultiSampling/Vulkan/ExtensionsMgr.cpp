@@ -2,6 +2,7 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include "ValidationLayerMgr.h"
+#include "../AppOptions.h"
 
 void ExtensionsMgr::checkAvailableExtensions(const VkInstanceCreateInfo& createInfo)
 {
@@ -32,11 +33,16 @@ void ExtensionsMgr::checkRequiredGlfwExtensions()
 
 std::vector<const char*> ExtensionsMgr::getRequiredExtensions()
 {
-    uint32_t glfwExtensionCount = 0;
-    const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+    // Headless runs never initialize GLFW and need no surface extensions
+    std::vector<const char*> extensions;
+    if (!AppOptions::headless)
+    {
+        uint32_t glfwExtensionCount = 0;
+        const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
 
-    // Use glfwExtensions to initialize the vector
-    std::vector<const char*> extensions{glfwExtensions, glfwExtensions + glfwExtensionCount};
+        // Use glfwExtensions to initialize the vector
+        extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    }
     if (ValidationLayerMgr::enableValidationLayers)
     {
         extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -0,0 +1,206 @@
+#include "GpuTimelineMgr.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "LogicalDevicesMgr.h"
+#include "../AppOptions.h"
+
+TimelineBackend GpuTimelineMgr::backend = TimelineBackend::Fences;
+uint32_t GpuTimelineMgr::instanceApiVersion = VK_API_VERSION_1_0;
+VkSemaphore GpuTimelineMgr::timelineSemaphore = VK_NULL_HANDLE;
+PFN_vkWaitSemaphoresKHR GpuTimelineMgr::waitSemaphores = nullptr;
+PFN_vkGetSemaphoreCounterValueKHR GpuTimelineMgr::getSemaphoreCounterValue = nullptr;
+uint64_t GpuTimelineMgr::lastSubmittedValue = 0;
+uint64_t GpuTimelineMgr::lastCompletedValue = 0;
+std::deque<GpuTimelineMgr::PendingFence> GpuTimelineMgr::pendingFences{};
+std::vector<VkFence> GpuTimelineMgr::freeFences{};
+
+uint32_t GpuTimelineMgr::chooseInstanceApiVersion()
+{
+    // vkEnumerateInstanceVersion does not exist on 1.0 loaders, which can only create 1.0 instances
+    const auto enumerateInstanceVersion =
+        reinterpret_cast<PFN_vkEnumerateInstanceVersion>(vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion"));
+
+    uint32_t loaderVersion = VK_API_VERSION_1_0;
+    if (enumerateInstanceVersion != nullptr)
+        enumerateInstanceVersion(&loaderVersion);
+
+    instanceApiVersion = loaderVersion >= VK_API_VERSION_1_2 ? VK_API_VERSION_1_2 : loaderVersion >= VK_API_VERSION_1_1 ? VK_API_VERSION_1_1 : VK_API_VERSION_1_0;
+    return instanceApiVersion;
+}
+
+void GpuTimelineMgr::selectBackend(VkPhysicalDevice physicalDevice)
+{
+    backend = TimelineBackend::Fences;
+    if (AppOptions::fenceSync || instanceApiVersion < VK_API_VERSION_1_1)
+        return;
+
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> extensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensions.data());
+
+    bool hasExtension = false;
+    for (const auto& extension : extensions)
+        hasExtension |= std::strcmp(extension.extensionName, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) == 0;
+
+    const bool core = instanceApiVersion >= VK_API_VERSION_1_2 && deviceProperties.apiVersion >= VK_API_VERSION_1_2;
+    if (!core && !hasExtension)
+        return;
+
+    // The feature struct is the same for the core version and the extension
+    VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures{};
+    timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+
+    VkPhysicalDeviceFeatures2 features{};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &timelineFeatures;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+    if (timelineFeatures.timelineSemaphore)
+        backend = core ? TimelineBackend::CoreTimelineSemaphore : TimelineBackend::KhrTimelineSemaphore;
+}
+
+void GpuTimelineMgr::createTimeline()
+{
+    lastSubmittedValue = 0;
+    lastCompletedValue = 0;
+    if (backend == TimelineBackend::Fences)
+        return;
+
+    const bool core = backend == TimelineBackend::CoreTimelineSemaphore;
+    waitSemaphores = reinterpret_cast<PFN_vkWaitSemaphoresKHR>(
+        vkGetDeviceProcAddr(LogicalDevicesMgr::device, core ? "vkWaitSemaphores" : "vkWaitSemaphoresKHR"));
+    getSemaphoreCounterValue = reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(
+        vkGetDeviceProcAddr(LogicalDevicesMgr::device, core ? "vkGetSemaphoreCounterValue" : "vkGetSemaphoreCounterValueKHR"));
+    if (waitSemaphores == nullptr || getSemaphoreCounterValue == nullptr)
+        throw std::runtime_error("failed to load timeline semaphore functions!");
+
+    VkSemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+
+    if (vkCreateSemaphore(LogicalDevicesMgr::device, &semaphoreInfo, nullptr, &timelineSemaphore) != VK_SUCCESS)
+        throw std::runtime_error("failed to create timeline semaphore!");
+}
+
+void GpuTimelineMgr::destroyTimeline()
+{
+    waitForValue(lastSubmittedValue);
+
+    if (timelineSemaphore != VK_NULL_HANDLE)
+        vkDestroySemaphore(LogicalDevicesMgr::device, timelineSemaphore, nullptr);
+    timelineSemaphore = VK_NULL_HANDLE;
+
+    for (VkFence fence : freeFences)
+        vkDestroyFence(LogicalDevicesMgr::device, fence, nullptr);
+    freeFences.clear();
+}
+
+uint64_t GpuTimelineMgr::submit(VkQueue queue, const VkSubmitInfo& submitInfo)
+{
+    const uint64_t value = lastSubmittedValue + 1;
+
+    if (backend == TimelineBackend::Fences)
+    {
+        const VkFence fence = acquireFence();
+        if (vkQueueSubmit(queue, 1, &submitInfo, fence) != VK_SUCCESS)
+            throw std::runtime_error("failed to submit command buffer!");
+        pendingFences.push_back({value, fence});
+        lastSubmittedValue = value;
+        return value;
+    }
+
+    // Append the timeline to the caller's signal semaphores, values given for binary semaphores are ignored
+    std::vector<VkSemaphore> signalSemaphores(submitInfo.pSignalSemaphores, submitInfo.pSignalSemaphores + submitInfo.signalSemaphoreCount);
+    signalSemaphores.push_back(timelineSemaphore);
+    const std::vector<uint64_t> signalValues(signalSemaphores.size(), value);
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.pNext = submitInfo.pNext;
+    timelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size());
+    timelineInfo.pSignalSemaphoreValues = signalValues.data();
+
+    VkSubmitInfo timelineSubmitInfo = submitInfo;
+    timelineSubmitInfo.pNext = &timelineInfo;
+    timelineSubmitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+    timelineSubmitInfo.pSignalSemaphores = signalSemaphores.data();
+
+    if (vkQueueSubmit(queue, 1, &timelineSubmitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+        throw std::runtime_error("failed to submit command buffer!");
+
+    lastSubmittedValue = value;
+    return value;
+}
+
+uint64_t GpuTimelineMgr::getCompletedValue()
+{
+    if (backend != TimelineBackend::Fences)
+    {
+        getSemaphoreCounterValue(LogicalDevicesMgr::device, timelineSemaphore, &lastCompletedValue);
+        return lastCompletedValue;
+    }
+
+    // Submissions on one queue complete in order, so stop at the first fence that is still pending
+    while (!pendingFences.empty() && vkGetFenceStatus(LogicalDevicesMgr::device, pendingFences.front().fence) == VK_SUCCESS)
+    {
+        lastCompletedValue = pendingFences.front().value;
+        freeFences.push_back(pendingFences.front().fence);
+        pendingFences.pop_front();
+    }
+    return lastCompletedValue;
+}
+
+void GpuTimelineMgr::waitForValue(uint64_t value)
+{
+    if (value == 0 || value <= lastCompletedValue)
+        return;
+
+    if (backend != TimelineBackend::Fences)
+    {
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &timelineSemaphore;
+        waitInfo.pValues = &value;
+        waitSemaphores(LogicalDevicesMgr::device, &waitInfo, UINT64_MAX);
+        getCompletedValue();
+        return;
+    }
+
+    while (!pendingFences.empty() && pendingFences.front().value <= value)
+    {
+        vkWaitForFences(LogicalDevicesMgr::device, 1, &pendingFences.front().fence, VK_TRUE, UINT64_MAX);
+        getCompletedValue();
+    }
+}
+
+VkFence GpuTimelineMgr::acquireFence()
+{
+    getCompletedValue();
+    if (!freeFences.empty())
+    {
+        VkFence fence = freeFences.back();
+        freeFences.pop_back();
+        vkResetFences(LogicalDevicesMgr::device, 1, &fence);
+        return fence;
+    }
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    VkFence fence = VK_NULL_HANDLE;
+    if (vkCreateFence(LogicalDevicesMgr::device, &fenceInfo, nullptr, &fence) != VK_SUCCESS)
+        throw std::runtime_error("failed to create submission fence!");
+    return fence;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <deque>
+#include <vector>
+
+enum class TimelineBackend
+{
+    Fences,                  // One fence per submission, completion is polled in submission order
+    CoreTimelineSemaphore,   // Vulkan 1.2
+    KhrTimelineSemaphore     // VK_KHR_timeline_semaphore on a 1.1 device
+};
+
+// A single monotonically increasing GPU counter. Every graphics queue submission that goes through submit() signals the next
+// value, so frames, uploads and resource reclamation can all ask "has the GPU finished up to N" with one number.
+class GpuTimelineMgr
+{
+public:
+    // Highest instance version this code can use, the instance must be created with it for the core backend to be available
+    static uint32_t chooseInstanceApiVersion();
+    // Picks the backend for the physical device, LogicalDevicesMgr enables whatever it needs
+    static void selectBackend(VkPhysicalDevice physicalDevice);
+    static void createTimeline();
+    static void destroyTimeline();
+
+    static uint64_t submit(VkQueue queue, const VkSubmitInfo& submitInfo);
+    static uint64_t getLastSubmittedValue() { return lastSubmittedValue; }
+    static uint64_t getCompletedValue();
+    static void waitForValue(uint64_t value);
+
+    static TimelineBackend backend;
+    static uint32_t instanceApiVersion;
+
+private:
+    struct PendingFence
+    {
+        uint64_t value;
+        VkFence fence;
+    };
+
+    static VkFence acquireFence();
+
+    static VkSemaphore timelineSemaphore;
+    static PFN_vkWaitSemaphoresKHR waitSemaphores;
+    static PFN_vkGetSemaphoreCounterValueKHR getSemaphoreCounterValue;
+
+    static uint64_t lastSubmittedValue;
+    static uint64_t lastCompletedValue;
+    static std::deque<PendingFence> pendingFences;
+    static std::vector<VkFence> freeFences;
+};
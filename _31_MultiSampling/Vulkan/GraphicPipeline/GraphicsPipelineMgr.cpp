@@ -1,43 +1,90 @@
 #include "GraphicsPipelineMgr.h"
 
+#include <algorithm>
+#include <array>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #include "../DepthBufferMgr.h"
 #include "../DescriptorMgr.h"
 #include "../LogicalDevicesMgr.h"
 #include "../MsaaMgr.h"
 #include "../PhysicalDevicesMgr.h"
+#include "PipelineCacheMgr.h"
+#include "PipelineLibrary.h"
 #include "Shaders/ShadersMgr.h"
 #include "../SwapChain/SwapChainMgr.h"
-#include "../Vertex/Vertex.h"
+#include "../Instancing/InstanceBufferMgr.h"
+#include "../Vertex/GeometryPoolMgr.h"
 
-VkPipeline GraphicsPipelineMgr::graphicsPipeline = nullptr;
 VkPipelineLayout GraphicsPipelineMgr::pipelineLayout = nullptr;
 VkRenderPass GraphicsPipelineMgr::renderPass = nullptr;
+uint32_t GraphicsPipelineMgr::framesInFlight = 2;
+PipelineKey GraphicsPipelineMgr::pipelineKey{};
 
 
 void GraphicsPipelineMgr::createGraphicsPipeline(const std::string& vertFileName, const std::string& fragFileName)
 {
-    createRenderPass();
+    renderPass = createRenderPass(PhysicalDevicesMgr::msaaSamples);
     createPipelineLayout();
 
-    // Create shader modules
-    VkShaderModule vertShaderModule = ShadersMgr::createShaderModule(vertFileName);
-    VkShaderModule fragShaderModule = ShadersMgr::createShaderModule(fragFileName);
+    pipelineKey.samples = PhysicalDevicesMgr::msaaSamples;
+    pipelineKey.vertexInput = std::is_same_v<GpuVertex, QuantizedVertex> ? VertexInput::Quantized : VertexInput::FullPrecision;
+    pipelineKey.features.quantizedDecode = pipelineKey.vertexInput == VertexInput::Quantized;
 
-    // Create shader stages
-    VkPipelineShaderStageCreateInfo shaderStages[] = {getShaderStageCreateInfo(vertShaderModule, VK_SHADER_STAGE_VERTEX_BIT),
-                                                      getShaderStageCreateInfo(fragShaderModule, VK_SHADER_STAGE_FRAGMENT_BIT)};
+    // The first frame needs a pipeline to fall back to, every other permutation may finish whenever it does
+    PipelineLibrary::createLibrary(vertFileName, fragFileName);
+    PipelineLibrary::request(pipelineKey).wait();
+}
+
+PipelineState GraphicsPipelineMgr::getPipelineState(const PipelineKey& key, uint64_t vertShaderHash, uint64_t fragShaderHash)
+{
+    if (key.features.vertexColor && key.vertexInput != VertexInput::FullPrecision)
+        throw std::invalid_argument("vertex colors need the full precision vertex layout");
+
+    PipelineState state;
+    state.vertShaderHash = vertShaderHash;
+    state.fragShaderHash = fragShaderHash;
+    state.features = key.features;
+    state.vertexInput = key.vertexInput;
+    state.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    state.polygonMode = VK_POLYGON_MODE_FILL;
+    state.cullMode = key.cullMode;
+    state.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    state.samples = key.samples;
+    state.sampleShadingEnable = VK_TRUE;
+    state.minSampleShading = 0.2f;
+    state.depthTestEnable = VK_TRUE;
+    // Blended surfaces are tested against the depth buffer but must not hide what is drawn behind them later
+    state.depthWriteEnable = key.blendMode == BlendMode::Opaque ? VK_TRUE : VK_FALSE;
+    state.depthCompareOp = VK_COMPARE_OP_LESS;
+    state.colorBlend = getColorBlendAttachmentState(key.blendMode);
+    state.colorFormat = SwapChainMgr::imageFormat;
+    state.depthFormat = DepthBufferMgr::findDepthFormat();
+    state.layout = pipelineLayout;
+    return state;
+}
+
+VkPipeline GraphicsPipelineMgr::createPipeline(const PipelineState& state, VkShaderModule vertShaderModule, VkShaderModule fragShaderModule,
+                                               VkRenderPass compatibleRenderPass)
+{
+    // Called from worker threads, so all state lives on this stack
+    SpecializationConstants specializationConstants = state.features.getSpecializationConstants();
+    const VkSpecializationInfo* specializationInfo = specializationConstants.getInfo();
+    VkPipelineShaderStageCreateInfo shaderStages[] = {
+        getShaderStageCreateInfo(vertShaderModule, VK_SHADER_STAGE_VERTEX_BIT, specializationInfo),
+        getShaderStageCreateInfo(fragShaderModule, VK_SHADER_STAGE_FRAGMENT_BIT, specializationInfo)};
 
     // Fixed functions
-    VkPipelineVertexInputStateCreateInfo vertexInput = getVertexInputStateCreateInfo();
-    VkPipelineInputAssemblyStateCreateInfo inputAssembly = getInputAssemblyStateCreateInfo();
+    VkPipelineVertexInputStateCreateInfo vertexInput = getVertexInputStateCreateInfo(state.vertexInput);
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly = getInputAssemblyStateCreateInfo(state);
     VkPipelineViewportStateCreateInfo viewportState = getViewportStateCreateInfo();
-    VkPipelineRasterizationStateCreateInfo rasterizer = getRasterizationStateCreateInfo();
-    VkPipelineMultisampleStateCreateInfo multisampling = getMultisamplingStateCreateInfo();
-    VkPipelineColorBlendStateCreateInfo colorBlending = getColorBlendStateCreateInfo();
+    VkPipelineRasterizationStateCreateInfo rasterizer = getRasterizationStateCreateInfo(state);
+    VkPipelineMultisampleStateCreateInfo multisampling = getMultisamplingStateCreateInfo(state);
+    VkPipelineColorBlendStateCreateInfo colorBlending = getColorBlendStateCreateInfo(&state.colorBlend);
     VkPipelineDynamicStateCreateInfo dynamicState = getVKDynamicStateCreateInfo();
-    VkPipelineDepthStencilStateCreateInfo depthStencil = getDepthStencilStateCreateInfo();
+    VkPipelineDepthStencilStateCreateInfo depthStencil = getDepthStencilStateCreateInfo(state);
 
     VkGraphicsPipelineCreateInfo pipelineCreateInfo = {VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
     pipelineCreateInfo.stageCount = 2;
@@ -47,22 +94,19 @@ void GraphicsPipelineMgr::createGraphicsPipeline(const std::string& vertFileName
     pipelineCreateInfo.pViewportState = &viewportState;
     pipelineCreateInfo.pRasterizationState = &rasterizer;
     pipelineCreateInfo.pMultisampleState = &multisampling;
-    pipelineCreateInfo.pDepthStencilState = nullptr;
     pipelineCreateInfo.pColorBlendState = &colorBlending;
     pipelineCreateInfo.pDynamicState = &dynamicState;
     pipelineCreateInfo.pDepthStencilState = &depthStencil;
-    pipelineCreateInfo.layout = pipelineLayout;
+    pipelineCreateInfo.layout = state.layout;
     pipelineCreateInfo.subpass = 0;
-    pipelineCreateInfo.renderPass = renderPass;
+    pipelineCreateInfo.renderPass = compatibleRenderPass;
     pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
     pipelineCreateInfo.basePipelineIndex = -1;
 
-    if (vkCreateGraphicsPipelines(LogicalDevicesMgr::device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &graphicsPipeline) != VK_SUCCESS)
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    if (vkCreateGraphicsPipelines(LogicalDevicesMgr::device, PipelineCacheMgr::pipelineCache, 1, &pipelineCreateInfo, nullptr, &pipeline) != VK_SUCCESS)
         throw std::runtime_error("failed to create graphics pipeline");
-
-    // // Clean up shader modules
-    ShadersMgr::destroyShaderModule(vertShaderModule);
-    ShadersMgr::destroyShaderModule(fragShaderModule);
+    return pipeline;
 }
 
 void GraphicsPipelineMgr::createPipelineLayout()
@@ -75,90 +119,111 @@ void GraphicsPipelineMgr::createPipelineLayout()
 
 void GraphicsPipelineMgr::destroyGraphicsPipeline()
 {
-    vkDestroyPipeline(LogicalDevicesMgr::device, graphicsPipeline, nullptr);
+    PipelineLibrary::destroyLibrary();
     destroyPipelineLayout();
     destroyRenderPass();
 }
 
-VkPipelineDepthStencilStateCreateInfo GraphicsPipelineMgr::getDepthStencilStateCreateInfo()
+VkPipelineDepthStencilStateCreateInfo GraphicsPipelineMgr::getDepthStencilStateCreateInfo(const PipelineState& state)
 {
     VkPipelineDepthStencilStateCreateInfo depthStencil{};
     depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-    depthStencil.depthTestEnable = VK_TRUE;
-    depthStencil.depthWriteEnable = VK_TRUE;
-    depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+    depthStencil.depthTestEnable = state.depthTestEnable;
+    depthStencil.depthWriteEnable = state.depthWriteEnable;
+    depthStencil.depthCompareOp = state.depthCompareOp;
     depthStencil.depthBoundsTestEnable = VK_FALSE;
     depthStencil.stencilTestEnable = VK_FALSE;
     return depthStencil;
 }
 
 
-VkPipelineShaderStageCreateInfo GraphicsPipelineMgr::getShaderStageCreateInfo(VkShaderModule shaderModule, VkShaderStageFlagBits stage)
+VkPipelineShaderStageCreateInfo GraphicsPipelineMgr::getShaderStageCreateInfo(VkShaderModule shaderModule, VkShaderStageFlagBits stage,
+                                                                              const VkSpecializationInfo* specializationInfo)
 {
     VkPipelineShaderStageCreateInfo shaderStageInfo = {};
     shaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     shaderStageInfo.stage = stage;
     shaderStageInfo.module = shaderModule;
     shaderStageInfo.pName = "main";
+    shaderStageInfo.pSpecializationInfo = specializationInfo;
     return shaderStageInfo;
 }
 
+VkPipelineVertexInputStateCreateInfo GraphicsPipelineMgr::getVertexInputStateCreateInfo(VertexInput vertexInput)
+{
+    return vertexInput == VertexInput::Quantized ? getVertexInputStateCreateInfo<QuantizedVertex>() : getVertexInputStateCreateInfo<FullPrecisionVertex>();
+}
+
+template <typename Layout>
 VkPipelineVertexInputStateCreateInfo GraphicsPipelineMgr::getVertexInputStateCreateInfo()
 {
-    static auto bindingDescription = Vertex::getBindingDescription();
-    static auto attributeDescriptions = Vertex::getAttributeDescriptions();
+    // Binding 0 is the mesh in the geometry pool, binding 1 the per instance data. Static locals are initialized once even when
+    // several workers get here at the same time, and only read afterwards.
+    static const std::array<VkVertexInputBindingDescription, 2> bindingDescriptions = {
+        Layout::getBindingDescription(), InstanceBufferMgr::getBindingDescription()};
+    static const auto attributeDescriptions = []()
+    {
+        const auto vertexAttributes = Layout::getAttributeDescriptions();
+        const auto instanceAttributes = InstanceBufferMgr::getAttributeDescriptions();
+        std::vector<VkVertexInputAttributeDescription> attributes(vertexAttributes.begin(), vertexAttributes.end());
+        attributes.insert(attributes.end(), instanceAttributes.begin(), instanceAttributes.end());
+
+        // Triangle.vert declares the color at location 1 for the vertex color variant. Layouts without one feed it the position
+        // instead, so every declared input has an attribute; the shader only reads it when VERTEX_COLOR is set.
+        const auto hasLocation = [&attributes](uint32_t location)
+        {
+            return std::any_of(attributes.begin(), attributes.end(), [location](const auto& attribute) { return attribute.location == location; });
+        };
+        if (!hasLocation(1))
+        {
+            VkVertexInputAttributeDescription color = vertexAttributes[0];
+            color.location = 1;
+            attributes.push_back(color);
+        }
+        return attributes;
+    }();
+
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputInfo.vertexBindingDescriptionCount = 1;
-    vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+    vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
+    vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
     vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
     vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
     return vertexInputInfo;
 }
 
-VkPipelineInputAssemblyStateCreateInfo GraphicsPipelineMgr::getInputAssemblyStateCreateInfo()
+VkPipelineInputAssemblyStateCreateInfo GraphicsPipelineMgr::getInputAssemblyStateCreateInfo(const PipelineState& state)
 {
     VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
     inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    inputAssembly.topology = state.topology;
     inputAssembly.primitiveRestartEnable = VK_FALSE;
     return inputAssembly;
 }
 
 VkPipelineViewportStateCreateInfo GraphicsPipelineMgr::getViewportStateCreateInfo()
 {
-    static VkViewport viewport{};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = static_cast<float>(SwapChainMgr::imageExtent.width);
-    viewport.height = static_cast<float>(SwapChainMgr::imageExtent.height);
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-
-    static VkRect2D scissor{};
-    scissor.offset = {0, 0};
-    scissor.extent = SwapChainMgr::imageExtent;
-
+    // Viewport and scissor are dynamic, so only their count is baked in and one pipeline serves every swap chain extent
     VkPipelineViewportStateCreateInfo viewportState{};
     viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
     viewportState.viewportCount = 1;
-    viewportState.pViewports = &viewport;
+    viewportState.pViewports = nullptr;
     viewportState.scissorCount = 1;
-    viewportState.pScissors = &scissor;
+    viewportState.pScissors = nullptr;
 
     return viewportState;
 }
 
-VkPipelineRasterizationStateCreateInfo GraphicsPipelineMgr::getRasterizationStateCreateInfo()
+VkPipelineRasterizationStateCreateInfo GraphicsPipelineMgr::getRasterizationStateCreateInfo(const PipelineState& state)
 {
     VkPipelineRasterizationStateCreateInfo rasterizer{};
     rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
     rasterizer.depthClampEnable = VK_FALSE;
     rasterizer.rasterizerDiscardEnable = VK_FALSE;
-    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.polygonMode = state.polygonMode;
     rasterizer.lineWidth = 1.0f;
-    rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
-    rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterizer.cullMode = state.cullMode;
+    rasterizer.frontFace = state.frontFace;
     rasterizer.depthBiasEnable = VK_FALSE;
     rasterizer.depthBiasConstantFactor = 0.0f;
     rasterizer.depthBiasClamp = 0.0f;
@@ -166,22 +231,22 @@ VkPipelineRasterizationStateCreateInfo GraphicsPipelineMgr::getRasterizationStat
     return rasterizer;
 }
 
-VkPipelineMultisampleStateCreateInfo GraphicsPipelineMgr::getMultisamplingStateCreateInfo()
+VkPipelineMultisampleStateCreateInfo GraphicsPipelineMgr::getMultisamplingStateCreateInfo(const PipelineState& state)
 {
     VkPipelineMultisampleStateCreateInfo multisampling{};
     multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-    multisampling.sampleShadingEnable = VK_TRUE;
-    multisampling.minSampleShading = 0.2f;
-    multisampling.rasterizationSamples = PhysicalDevicesMgr::msaaSamples;
+    multisampling.sampleShadingEnable = state.sampleShadingEnable;
+    multisampling.minSampleShading = state.minSampleShading;
+    multisampling.rasterizationSamples = state.samples;
     multisampling.pSampleMask = nullptr;
     multisampling.alphaToCoverageEnable = VK_FALSE;
     multisampling.alphaToOneEnable = VK_FALSE;
     return multisampling;
 }
 
-VkPipelineColorBlendStateCreateInfo GraphicsPipelineMgr::getColorBlendStateCreateInfo()
+VkPipelineColorBlendAttachmentState GraphicsPipelineMgr::getColorBlendAttachmentState(BlendMode blendMode)
 {
-    static VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
     colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT |
                                           VK_COLOR_COMPONENT_G_BIT |
                                           VK_COLOR_COMPONENT_B_BIT |
@@ -194,12 +259,31 @@ VkPipelineColorBlendStateCreateInfo GraphicsPipelineMgr::getColorBlendStateCreat
     colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
     colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
 
+    if (blendMode == BlendMode::AlphaBlend)
+    {
+        colorBlendAttachment.blendEnable = VK_TRUE;
+        colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    }
+    else if (blendMode == BlendMode::Additive)
+    {
+        colorBlendAttachment.blendEnable = VK_TRUE;
+        colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+        colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    }
+    return colorBlendAttachment;
+}
+
+VkPipelineColorBlendStateCreateInfo GraphicsPipelineMgr::getColorBlendStateCreateInfo(const VkPipelineColorBlendAttachmentState* colorBlendAttachment)
+{
     VkPipelineColorBlendStateCreateInfo colorBlending{};
     colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
     colorBlending.logicOpEnable = VK_FALSE;
     colorBlending.logicOp = VK_LOGIC_OP_COPY;
     colorBlending.attachmentCount = 1;
-    colorBlending.pAttachments = &colorBlendAttachment;
+    colorBlending.pAttachments = colorBlendAttachment;
     colorBlending.blendConstants[0] = 0.0f;
     colorBlending.blendConstants[1] = 0.0f;
     colorBlending.blendConstants[2] = 0.0f;
@@ -225,8 +309,9 @@ VkPipelineLayoutCreateInfo GraphicsPipelineMgr::getPipelineLayoutCreateInfo()
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     pipelineLayoutInfo.setLayoutCount = 1;
     pipelineLayoutInfo.pSetLayouts = &DescriptorMgr::descriptorSetLayout;
-    pipelineLayoutInfo.pushConstantRangeCount = 0;
-    pipelineLayoutInfo.pPushConstantRanges = nullptr;
+    static VkPushConstantRange pushConstantRange = {VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(MeshPushConstants)};
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
     return pipelineLayoutInfo;
 }
 
@@ -236,11 +321,11 @@ void GraphicsPipelineMgr::destroyPipelineLayout()
 }
 
 
-void GraphicsPipelineMgr::createRenderPass()
+VkRenderPass GraphicsPipelineMgr::createRenderPass(VkSampleCountFlagBits samples)
 {
     VkAttachmentDescription colorAttachment{};
     colorAttachment.format = SwapChainMgr::imageFormat;
-    colorAttachment.samples = PhysicalDevicesMgr::msaaSamples;
+    colorAttachment.samples = samples;
     colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
     colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
     colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
@@ -254,7 +339,7 @@ void GraphicsPipelineMgr::createRenderPass()
 
     VkAttachmentDescription depthAttachment{};
     depthAttachment.format = DepthBufferMgr::findDepthFormat();
-    depthAttachment.samples = PhysicalDevicesMgr::msaaSamples;
+    depthAttachment.samples = samples;
     depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
     depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
@@ -274,7 +359,7 @@ void GraphicsPipelineMgr::createRenderPass()
     colorAttachmentResolve.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachmentResolve.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     colorAttachmentResolve.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachmentResolve.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    colorAttachmentResolve.finalLayout = SwapChainMgr::getFinalLayout();
 
     VkAttachmentReference colorAttachmentResolveRef{};
     colorAttachmentResolveRef.attachment = 2;
@@ -306,10 +391,12 @@ void GraphicsPipelineMgr::createRenderPass()
     renderPassInfo.dependencyCount = 1;
     renderPassInfo.pDependencies = &dependency;
 
-    if (vkCreateRenderPass(LogicalDevicesMgr::device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS)
+    VkRenderPass createdRenderPass = VK_NULL_HANDLE;
+    if (vkCreateRenderPass(LogicalDevicesMgr::device, &renderPassInfo, nullptr, &createdRenderPass) != VK_SUCCESS)
     {
         throw std::runtime_error("failed to create render pass!");
     }
+    return createdRenderPass;
 }
 
 
@@ -2,33 +2,52 @@
 #include <vulkan/vulkan_core.h>
 #include <string>
 
+#include "PipelineKey.h"
+#include "PipelineState.h"
+
 class GraphicsPipelineMgr
 {
 public:
+    // Creates the render pass and layout and builds the pipeline for pipelineKey, other permutations go through PipelineLibrary
     static void createGraphicsPipeline(const std::string& vertFileName, const std::string& fragFileName);
 
     static void destroyGraphicsPipeline();
 
-    static VkPipeline graphicsPipeline;
+    // Resolves a permutation to the complete state its pipeline is built from
+    static PipelineState getPipelineState(const PipelineKey& key, uint64_t vertShaderHash, uint64_t fragShaderHash);
+    // Thread safe, compatibleRenderPass has to match state.samples and the formats
+    static VkPipeline createPipeline(const PipelineState& state, VkShaderModule vertShaderModule, VkShaderModule fragShaderModule,
+                                     VkRenderPass compatibleRenderPass);
+    // Same attachments as renderPass with a different sample count
+    static VkRenderPass createRenderPass(VkSampleCountFlagBits samples);
+
+    // The permutation the frame is drawn with, PipelineLibrary substitutes a ready one while it compiles
+    static PipelineKey pipelineKey;
     static VkRenderPass renderPass;
     static VkPipelineLayout pipelineLayout;
-    static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
+    // Number of frames the CPU may record ahead of the GPU, every per frame resource is sized by it. Only change it through
+    // HelloTriangleApplication::setFramesInFlight, which rebuilds those resources.
+    static uint32_t framesInFlight;
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 4;
 
 private:
     static void destroyRenderPass();
     static void destroyPipelineLayout();
-    static void createRenderPass();
     static void createPipelineLayout();
-    static VkPipelineShaderStageCreateInfo getShaderStageCreateInfo(VkShaderModule shaderModule, VkShaderStageFlagBits stage);
+    static VkPipelineShaderStageCreateInfo getShaderStageCreateInfo(VkShaderModule shaderModule, VkShaderStageFlagBits stage,
+                                                                    const VkSpecializationInfo* specializationInfo);
+    static VkPipelineVertexInputStateCreateInfo getVertexInputStateCreateInfo(VertexInput vertexInput);
+    template <typename Layout>
     static VkPipelineVertexInputStateCreateInfo getVertexInputStateCreateInfo();
-    static VkPipelineInputAssemblyStateCreateInfo getInputAssemblyStateCreateInfo();
+    static VkPipelineInputAssemblyStateCreateInfo getInputAssemblyStateCreateInfo(const PipelineState& state);
     static VkPipelineViewportStateCreateInfo getViewportStateCreateInfo();
-    static VkPipelineRasterizationStateCreateInfo getRasterizationStateCreateInfo();
-    static VkPipelineMultisampleStateCreateInfo getMultisamplingStateCreateInfo();
-    static VkPipelineColorBlendStateCreateInfo getColorBlendStateCreateInfo();
+    static VkPipelineRasterizationStateCreateInfo getRasterizationStateCreateInfo(const PipelineState& state);
+    static VkPipelineMultisampleStateCreateInfo getMultisamplingStateCreateInfo(const PipelineState& state);
+    static VkPipelineColorBlendAttachmentState getColorBlendAttachmentState(BlendMode blendMode);
+    static VkPipelineColorBlendStateCreateInfo getColorBlendStateCreateInfo(const VkPipelineColorBlendAttachmentState* colorBlendAttachment);
     static VkPipelineDynamicStateCreateInfo getVKDynamicStateCreateInfo();
     static VkPipelineLayoutCreateInfo getPipelineLayoutCreateInfo();
-    static VkPipelineDepthStencilStateCreateInfo getDepthStencilStateCreateInfo();
+    static VkPipelineDepthStencilStateCreateInfo getDepthStencilStateCreateInfo(const PipelineState& state);
 };
 
 
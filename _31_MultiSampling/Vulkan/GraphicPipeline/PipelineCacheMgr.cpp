@@ -0,0 +1,103 @@
+#include "PipelineCacheMgr.h"
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "../LogicalDevicesMgr.h"
+#include "../PhysicalDevicesMgr.h"
+#include "../../AppOptions.h"
+#include "../Utils/FileHelper.h"
+#include "../Utils/MappedFile.h"
+
+VkPipelineCache PipelineCacheMgr::pipelineCache = VK_NULL_HANDLE;
+std::string PipelineCacheMgr::cachePath = "pipeline.cache";
+bool PipelineCacheMgr::warm = false;
+
+void PipelineCacheMgr::createPipelineCache()
+{
+    warm = false;
+    if (!AppOptions::coldPipelineCache)
+        pipelineCache = loadCacheFile(cachePath);
+
+    if (pipelineCache != VK_NULL_HANDLE)
+    {
+        warm = true;
+        return;
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    if (vkCreatePipelineCache(LogicalDevicesMgr::device, &cacheInfo, nullptr, &pipelineCache) != VK_SUCCESS)
+        throw std::runtime_error("failed to create pipeline cache!");
+}
+
+void PipelineCacheMgr::savePipelineCache()
+{
+    if (pipelineCache == VK_NULL_HANDLE)
+        return;
+
+    // Another instance may have saved pipelines this run never built, merging keeps both instead of the last writer winning
+    const VkPipelineCache onDisk = loadCacheFile(cachePath);
+    if (onDisk != VK_NULL_HANDLE)
+    {
+        vkMergePipelineCaches(LogicalDevicesMgr::device, pipelineCache, 1, &onDisk);
+        vkDestroyPipelineCache(LogicalDevicesMgr::device, onDisk, nullptr);
+    }
+
+    size_t size = 0;
+    if (vkGetPipelineCacheData(LogicalDevicesMgr::device, pipelineCache, &size, nullptr) != VK_SUCCESS || size == 0)
+        return;
+    std::vector<char> data(size);
+    if (vkGetPipelineCacheData(LogicalDevicesMgr::device, pipelineCache, &size, data.data()) != VK_SUCCESS)
+        return;
+
+    std::string error;
+    if (!FileHelper::writeFileAtomically(cachePath, {{data.data(), size}}, error))
+        std::cerr << "pipeline cache: cannot write " << cachePath << ": " << error << '\n';
+}
+
+void PipelineCacheMgr::destroyPipelineCache()
+{
+    vkDestroyPipelineCache(LogicalDevicesMgr::device, pipelineCache, nullptr);
+    pipelineCache = VK_NULL_HANDLE;
+}
+
+bool PipelineCacheMgr::isCompatible(const void* data, size_t size)
+{
+    VkPipelineCacheHeaderVersionOne header;
+    if (size < sizeof(header))
+        return false;
+    std::memcpy(&header, data, sizeof(header));
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(PhysicalDevicesMgr::physicalDevice, &properties);
+
+    // The UUID changes with the driver build, which is what actually invalidates compiled pipelines
+    return header.headerSize >= sizeof(header) && header.headerSize <= size &&
+        header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE && header.vendorID == properties.vendorID &&
+        header.deviceID == properties.deviceID && std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+VkPipelineCache PipelineCacheMgr::loadCacheFile(const std::string& path)
+{
+    MappedFile file;
+    if (!file.open(path))
+        return VK_NULL_HANDLE;
+    if (!isCompatible(file.data(), file.size()))
+    {
+        std::cout << "pipeline cache: ignoring " << path << ", it was written for another device or driver\n";
+        return VK_NULL_HANDLE;
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = file.size();
+    cacheInfo.pInitialData = file.data();
+
+    VkPipelineCache cache = VK_NULL_HANDLE;
+    if (vkCreatePipelineCache(LogicalDevicesMgr::device, &cacheInfo, nullptr, &cache) != VK_SUCCESS)
+        return VK_NULL_HANDLE;
+    return cache;
+}
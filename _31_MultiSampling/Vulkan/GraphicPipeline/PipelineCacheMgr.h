@@ -0,0 +1,26 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <string>
+
+// One VkPipelineCache shared by every pipeline creation and kept on disk between runs. The driver owns the blob format, only
+// its header is checked here: a blob from another vendor, device or driver build is dropped instead of handed to the driver.
+class PipelineCacheMgr
+{
+public:
+    // Call after the logical device is created and before any pipeline is
+    static void createPipelineCache();
+    // Merges whatever another run wrote since startup, then replaces the file atomically. Call before the device is destroyed.
+    static void savePipelineCache();
+    static void destroyPipelineCache();
+
+    static VkPipelineCache pipelineCache;
+    static std::string cachePath;
+    // True when the cache was created from a valid blob, i.e. pipelines are expected to be created without compiling
+    static bool warm;
+
+private:
+    static bool isCompatible(const void* data, size_t size);
+    // Returns VK_NULL_HANDLE when the file is missing or was written for another device or driver
+    static VkPipelineCache loadCacheFile(const std::string& path);
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "Shaders/ShaderFeatures.h"
+#include "../Utils/Hash.h"
+
+enum class BlendMode : uint8_t
+{
+    Opaque,
+    AlphaBlend,
+    Additive
+};
+
+enum class VertexInput : uint8_t
+{
+    Quantized,    // QuantizedVertex
+    FullPrecision // FullPrecisionVertex
+};
+
+// Every piece of graphics pipeline state that differs between permutations, the rest is fixed by GraphicsPipelineMgr
+struct PipelineKey
+{
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+    BlendMode blendMode = BlendMode::Opaque;
+    VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+    VertexInput vertexInput = VertexInput::Quantized;
+    ShaderFeatures features;
+
+    bool operator==(const PipelineKey& other) const
+    {
+        return samples == other.samples && blendMode == other.blendMode && cullMode == other.cullMode && vertexInput == other.vertexInput &&
+            features == other.features;
+    }
+
+    uint64_t hash() const
+    {
+        uint64_t hash = hashValue(samples);
+        hash = hashValue(blendMode, hash);
+        hash = hashValue(cullMode, hash);
+        hash = hashValue(vertexInput, hash);
+        return features.hash(hash);
+    }
+};
+
+namespace std
+{
+template <>
+struct hash<PipelineKey>
+{
+    size_t operator()(PipelineKey const& key) const
+    {
+        return static_cast<size_t>(key.hash());
+    }
+};
+}
@@ -0,0 +1,126 @@
+#include "PipelineLibrary.h"
+
+#include <chrono>
+#include <stdexcept>
+
+#include "GraphicsPipelineMgr.h"
+#include "PipelineStateCache.h"
+#include "../LogicalDevicesMgr.h"
+#include "../PhysicalDevicesMgr.h"
+#include "Shaders/ShaderRegistry.h"
+
+VkShaderModule PipelineLibrary::vertShaderModule = VK_NULL_HANDLE;
+VkShaderModule PipelineLibrary::fragShaderModule = VK_NULL_HANDLE;
+uint64_t PipelineLibrary::vertShaderHash = 0;
+uint64_t PipelineLibrary::fragShaderHash = 0;
+std::unordered_map<PipelineKey, PipelineState> PipelineLibrary::states{};
+std::unordered_map<VkSampleCountFlagBits, VkRenderPass> PipelineLibrary::compatibleRenderPasses{};
+
+void PipelineLibrary::createLibrary(const std::string& vertFileName, const std::string& fragFileName)
+{
+    // Owned by the registry and alive until it is destroyed, so every build can use them
+    vertShaderModule = ShaderRegistry::getShaderModule(vertFileName);
+    fragShaderModule = ShaderRegistry::getShaderModule(fragFileName);
+    vertShaderHash = ShaderRegistry::getContentHash(vertFileName);
+    fragShaderHash = ShaderRegistry::getContentHash(fragFileName);
+}
+
+void PipelineLibrary::destroyLibrary()
+{
+    PipelineStateCache::destroyCache();
+    states.clear();
+
+    for (auto& [samples, renderPass] : compatibleRenderPasses)
+        vkDestroyRenderPass(LogicalDevicesMgr::device, renderPass, nullptr);
+    compatibleRenderPasses.clear();
+
+    vertShaderModule = VK_NULL_HANDLE;
+    fragShaderModule = VK_NULL_HANDLE;
+}
+
+std::shared_future<VkPipeline> PipelineLibrary::request(const PipelineKey& key)
+{
+    const PipelineState& state = getState(key);
+    const VkRenderPass renderPass = getCompatibleRenderPass(key.samples);
+    const VkShaderModule vert = vertShaderModule;
+    const VkShaderModule frag = fragShaderModule;
+    return PipelineStateCache::acquire(state, [state, vert, frag, renderPass]()
+    {
+        return GraphicsPipelineMgr::createPipeline(state, vert, frag, renderPass);
+    });
+}
+
+VkPipeline PipelineLibrary::getPipeline(const PipelineKey& key)
+{
+    const std::shared_future<VkPipeline> exact = request(key);
+    if (isReady(exact))
+        return exact.get();
+
+    // Blend mode, cull mode and shader features only change how the frame looks for the few frames the exact permutation still
+    // compiles
+    const PipelineKey* closestKey = nullptr;
+    int closestDifference = 0;
+    for (const auto& [candidateKey, candidateState] : states)
+    {
+        if (candidateKey.samples != key.samples || candidateKey.vertexInput != key.vertexInput)
+            continue;
+        const std::shared_future<VkPipeline>* candidate = PipelineStateCache::find(candidateState);
+        if (candidate == nullptr || !isReady(*candidate))
+            continue;
+
+        const int difference = (candidateKey.blendMode != key.blendMode) + (candidateKey.cullMode != key.cullMode) +
+            (candidateKey.features != key.features);
+        if (closestKey == nullptr || difference < closestDifference)
+        {
+            closestKey = &candidateKey;
+            closestDifference = difference;
+        }
+    }
+
+    // Requesting the fallback again marks it as used by this frame, so it cannot be evicted while the frame is in flight
+    return closestKey != nullptr ? request(*closestKey).get() : exact.get();
+}
+
+size_t PipelineLibrary::getPendingCount()
+{
+    size_t pending = 0;
+    for (const auto& [key, state] : states)
+    {
+        const std::shared_future<VkPipeline>* pipeline = PipelineStateCache::find(state);
+        pending += pipeline != nullptr && !isReady(*pipeline) ? 1 : 0;
+    }
+    return pending;
+}
+
+const PipelineState& PipelineLibrary::getState(const PipelineKey& key)
+{
+    const auto existing = states.find(key);
+    if (existing != states.end())
+        return existing->second;
+
+    // Every power of two up to the count the renderer picked is supported by the device. The render pass always resolves, which
+    // a single sampled attachment cannot.
+    if (key.samples > PhysicalDevicesMgr::msaaSamples || (key.samples == VK_SAMPLE_COUNT_1_BIT && key.samples != PhysicalDevicesMgr::msaaSamples))
+        throw std::invalid_argument("pipeline permutation uses a sample count the render pass cannot have");
+
+    return states.emplace(key, GraphicsPipelineMgr::getPipelineState(key, vertShaderHash, fragShaderHash)).first->second;
+}
+
+VkRenderPass PipelineLibrary::getCompatibleRenderPass(VkSampleCountFlagBits samples)
+{
+    if (samples == PhysicalDevicesMgr::msaaSamples)
+        return GraphicsPipelineMgr::renderPass;
+
+    const auto existing = compatibleRenderPasses.find(samples);
+    if (existing != compatibleRenderPasses.end())
+        return existing->second;
+
+    const VkRenderPass renderPass = GraphicsPipelineMgr::createRenderPass(samples);
+    compatibleRenderPasses.emplace(samples, renderPass);
+    return renderPass;
+}
+
+bool PipelineLibrary::isReady(const std::shared_future<VkPipeline>& pipeline)
+{
+    return pipeline.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <future>
+#include <string>
+#include <unordered_map>
+
+#include "PipelineKey.h"
+#include "PipelineState.h"
+
+// Graphics pipeline permutations of one shader pair. Keys are resolved to their full PipelineState, so keys that end up with
+// equal state share one pipeline in PipelineStateCache, which compiles them on the shared thread pool through PipelineCacheMgr's
+// cache. Only the thread recording frames may call in.
+class PipelineLibrary
+{
+public:
+    static void createLibrary(const std::string& vertFileName, const std::string& fragFileName);
+    // Waits for every build that is still running
+    static void destroyLibrary();
+
+    // Starts compiling the permutation unless an equal state is cached, the future holds the pipeline once it is built
+    static std::shared_future<VkPipeline> request(const PipelineKey& key);
+    // The exact permutation when it is ready. Otherwise it is requested and the closest ready permutation that can be used
+    // in its place is returned; one with the same sample count and vertex input. Waits only when there is none.
+    static VkPipeline getPipeline(const PipelineKey& key);
+    static size_t getPendingCount();
+
+private:
+    static const PipelineState& getState(const PipelineKey& key);
+    static VkRenderPass getCompatibleRenderPass(VkSampleCountFlagBits samples);
+    static bool isReady(const std::shared_future<VkPipeline>& pipeline);
+
+    static VkShaderModule vertShaderModule;
+    static VkShaderModule fragShaderModule;
+    static uint64_t vertShaderHash;
+    static uint64_t fragShaderHash;
+    static std::unordered_map<PipelineKey, PipelineState> states;
+    // Pipelines for sample counts the frame buffers do not use still need a render pass of that count to be created against
+    static std::unordered_map<VkSampleCountFlagBits, VkRenderPass> compatibleRenderPasses;
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+#include "PipelineKey.h"
+#include "../Utils/Hash.h"
+
+// Everything a graphics pipeline bakes in, filled by GraphicsPipelineMgr::getPipelineState. The create info helpers read only
+// from here, so two equal states always produce interchangeable pipelines. Viewport and scissor are dynamic and have no field:
+// nothing that depends on the swap chain extent is part of a pipeline.
+struct PipelineState
+{
+    uint64_t vertShaderHash = 0; // Of the SPIR-V, not of the file name
+    uint64_t fragShaderHash = 0;
+    ShaderFeatures features;
+    VertexInput vertexInput = VertexInput::Quantized;
+    VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+    VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+    VkFrontFace frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+    VkBool32 sampleShadingEnable = VK_FALSE;
+    float minSampleShading = 0.0f;
+    VkBool32 depthTestEnable = VK_TRUE;
+    VkBool32 depthWriteEnable = VK_TRUE;
+    VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS;
+    VkPipelineColorBlendAttachmentState colorBlend{};
+    // A render pass is compatible when its attachment formats and sample counts match
+    VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+    VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+
+    bool operator==(const PipelineState& other) const
+    {
+        return vertShaderHash == other.vertShaderHash && fragShaderHash == other.fragShaderHash && features == other.features && vertexInput == other.vertexInput &&
+            topology == other.topology && polygonMode == other.polygonMode && cullMode == other.cullMode && frontFace == other.frontFace &&
+            samples == other.samples && sampleShadingEnable == other.sampleShadingEnable && minSampleShading == other.minSampleShading &&
+            depthTestEnable == other.depthTestEnable && depthWriteEnable == other.depthWriteEnable && depthCompareOp == other.depthCompareOp &&
+            std::memcmp(&colorBlend, &other.colorBlend, sizeof(colorBlend)) == 0 && colorFormat == other.colorFormat &&
+            depthFormat == other.depthFormat && layout == other.layout;
+    }
+
+    uint64_t hash() const
+    {
+        uint64_t hash = hashValue(vertShaderHash);
+        hash = hashValue(fragShaderHash, hash);
+        hash = features.hash(hash);
+        hash = hashValue(vertexInput, hash);
+        hash = hashValue(topology, hash);
+        hash = hashValue(polygonMode, hash);
+        hash = hashValue(cullMode, hash);
+        hash = hashValue(frontFace, hash);
+        hash = hashValue(samples, hash);
+        hash = hashValue(sampleShadingEnable, hash);
+        hash = hashValue(minSampleShading, hash);
+        hash = hashValue(depthTestEnable, hash);
+        hash = hashValue(depthWriteEnable, hash);
+        hash = hashValue(depthCompareOp, hash);
+        hash = hashValue(colorBlend, hash);
+        hash = hashValue(colorFormat, hash);
+        hash = hashValue(depthFormat, hash);
+        return hashValue(layout, hash);
+    }
+};
+
+namespace std
+{
+template <>
+struct hash<PipelineState>
+{
+    size_t operator()(PipelineState const& state) const
+    {
+        return static_cast<size_t>(state.hash());
+    }
+};
+}
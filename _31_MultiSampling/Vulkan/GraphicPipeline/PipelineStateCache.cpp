@@ -0,0 +1,84 @@
+#include "PipelineStateCache.h"
+
+#include <chrono>
+
+#include "../DeletionQueueMgr.h"
+#include "../LogicalDevicesMgr.h"
+#include "../Utils/ThreadPool.h"
+
+size_t PipelineStateCache::maxPipelines = 64;
+std::unordered_map<PipelineState, PipelineStateCache::Entry> PipelineStateCache::entries{};
+std::list<PipelineState> PipelineStateCache::recentUses{};
+
+std::shared_future<VkPipeline> PipelineStateCache::acquire(const PipelineState& state, const std::function<VkPipeline()>& build)
+{
+    const auto existing = entries.find(state);
+    if (existing != entries.end())
+    {
+        recentUses.splice(recentUses.begin(), recentUses, existing->second.recentUse);
+        return existing->second.pipeline;
+    }
+
+    recentUses.push_front(state);
+    std::shared_future<VkPipeline> pipeline = ThreadPool::getShared().submit(build).share();
+    entries.emplace(state, Entry{pipeline, recentUses.begin()});
+    evict();
+    return pipeline;
+}
+
+const std::shared_future<VkPipeline>* PipelineStateCache::find(const PipelineState& state)
+{
+    const auto existing = entries.find(state);
+    return existing != entries.end() ? &existing->second.pipeline : nullptr;
+}
+
+void PipelineStateCache::destroyCache()
+{
+    for (auto& [state, entry] : entries)
+    {
+        entry.pipeline.wait();
+        try
+        {
+            vkDestroyPipeline(LogicalDevicesMgr::device, entry.pipeline.get(), nullptr);
+        }
+        catch (const std::exception&)
+        {
+            // The build failed, there is nothing to destroy
+        }
+    }
+    entries.clear();
+    recentUses.clear();
+}
+
+void PipelineStateCache::evict()
+{
+    // Builds still running are skipped, the worker would otherwise hand its pipeline to nobody
+    auto candidate = recentUses.end();
+    while (entries.size() > maxPipelines && candidate != recentUses.begin())
+    {
+        --candidate;
+        const auto entry = entries.find(*candidate);
+        if (!isReady(entry->second.pipeline))
+            continue;
+
+        std::shared_future<VkPipeline> pipeline = entry->second.pipeline;
+        DeletionQueueMgr::defer([pipeline]()
+        {
+            try
+            {
+                vkDestroyPipeline(LogicalDevicesMgr::device, pipeline.get(), nullptr);
+            }
+            catch (const std::exception&)
+            {
+                // The build failed, there is nothing to destroy
+            }
+        });
+        entries.erase(entry);
+        candidate = recentUses.erase(candidate);
+    }
+}
+
+bool PipelineStateCache::isReady(const std::shared_future<VkPipeline>& pipeline)
+{
+    return pipeline.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <functional>
+#include <future>
+#include <list>
+#include <unordered_map>
+
+#include "PipelineState.h"
+
+// Owns every graphics pipeline, keyed by the full PipelineState, and keeps at most maxPipelines of them. The least recently
+// acquired pipeline is evicted through DeletionQueueMgr, so frames still in flight may keep using it. Only the thread
+// recording frames may call in.
+class PipelineStateCache
+{
+public:
+    // Returns the pipeline of an equal state, or starts build on the shared thread pool. Either way the state becomes the most
+    // recently used, so a pipeline acquired for the frame being recorded is never the one evicted.
+    static std::shared_future<VkPipeline> acquire(const PipelineState& state, const std::function<VkPipeline()>& build);
+    // Null when the state was never built or has been evicted, does not count as a use
+    static const std::shared_future<VkPipeline>* find(const PipelineState& state);
+    // Waits for builds still running and destroys every pipeline, the GPU has to be idle
+    static void destroyCache();
+
+    static size_t maxPipelines;
+
+private:
+    struct Entry
+    {
+        std::shared_future<VkPipeline> pipeline;
+        std::list<PipelineState>::iterator recentUse;
+    };
+
+    static void evict();
+    static bool isReady(const std::shared_future<VkPipeline>& pipeline);
+
+    static std::unordered_map<PipelineState, Entry> entries;
+    static std::list<PipelineState> recentUses; // Most recently used first
+};
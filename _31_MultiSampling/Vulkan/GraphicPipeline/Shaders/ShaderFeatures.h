@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+
+#include "SpecializationConstants.h"
+#include "../../Utils/Hash.h"
+
+// The constant_id of every toggle, Triangle.vert and Triangle.frag declare the same numbers
+enum ShaderFeatureConstant : uint32_t
+{
+    TEXTURE_SAMPLING_CONSTANT = 0,
+    VERTEX_COLOR_CONSTANT = 1,
+    ALPHA_TEST_CONSTANT = 2,
+    QUANTIZED_DECODE_CONSTANT = 3,
+    ALPHA_CUTOFF_CONSTANT = 4
+};
+
+// Compile time toggles of the triangle shaders. They are baked in through specialization constants, so the driver removes the
+// paths a variant does not use from one shared SPIR-V file instead of branching on them per vertex or fragment.
+struct ShaderFeatures
+{
+    bool textureSampling = true;
+    // Needs a vertex layout that stores colors
+    bool vertexColor = false;
+    bool alphaTest = false;
+    // Maps normalized positions and texture coordinates back onto the mesh bounds, float layouts do not need it
+    bool quantizedDecode = true;
+    float alphaCutoff = 0.5f;
+
+    bool operator==(const ShaderFeatures& other) const
+    {
+        return textureSampling == other.textureSampling && vertexColor == other.vertexColor && alphaTest == other.alphaTest &&
+            quantizedDecode == other.quantizedDecode && alphaCutoff == other.alphaCutoff;
+    }
+    bool operator!=(const ShaderFeatures& other) const { return !(*this == other); }
+
+    uint64_t hash(uint64_t hash) const
+    {
+        hash = hashValue(textureSampling, hash);
+        hash = hashValue(vertexColor, hash);
+        hash = hashValue(alphaTest, hash);
+        hash = hashValue(quantizedDecode, hash);
+        return hashValue(alphaCutoff, hash);
+    }
+
+    SpecializationConstants getSpecializationConstants() const
+    {
+        SpecializationConstants constants;
+        constants.add(TEXTURE_SAMPLING_CONSTANT, textureSampling);
+        constants.add(VERTEX_COLOR_CONSTANT, vertexColor);
+        constants.add(ALPHA_TEST_CONSTANT, alphaTest);
+        constants.add(QUANTIZED_DECODE_CONSTANT, quantizedDecode);
+        constants.add(ALPHA_CUTOFF_CONSTANT, alphaCutoff);
+        return constants;
+    }
+};
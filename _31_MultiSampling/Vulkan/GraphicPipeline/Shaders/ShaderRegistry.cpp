@@ -0,0 +1,80 @@
+#include "ShaderRegistry.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "ShadersMgr.h"
+#include "../../Utils/Hash.h"
+#include "../../Utils/MappedFile.h"
+
+std::unordered_map<std::string, ShaderRegistry::Shader> ShaderRegistry::shadersByFile{};
+std::unordered_map<uint64_t, ShaderRegistry::Module> ShaderRegistry::modulesByContent{};
+
+namespace
+{
+constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+// Magic, version, generator, bound and schema
+constexpr size_t SPIRV_HEADER_SIZE = 5 * sizeof(uint32_t);
+}
+
+VkShaderModule ShaderRegistry::getShaderModule(const std::string& fileName)
+{
+    return loadShader(fileName).module;
+}
+
+uint64_t ShaderRegistry::getContentHash(const std::string& fileName)
+{
+    return loadShader(fileName).contentHash;
+}
+
+void ShaderRegistry::destroyRegistry()
+{
+    for (auto& [contentHash, module] : modulesByContent)
+        ShadersMgr::destroyShaderModule(module.module);
+    modulesByContent.clear();
+    shadersByFile.clear();
+}
+
+const ShaderRegistry::Shader& ShaderRegistry::loadShader(const std::string& fileName)
+{
+    const auto existing = shadersByFile.find(fileName);
+    if (existing != shadersByFile.end())
+        return existing->second;
+
+    MappedFile file;
+    if (!file.open(fileName))
+        throw std::runtime_error("Failed to open file " + fileName);
+
+    // SPIR-V is a stream of words, anything else is not a shader or was truncated. Files written on a machine of the other
+    // endianness carry a byte swapped magic, which Vulkan does not accept either.
+    uint32_t magic = 0;
+    if (file.size() >= sizeof(magic))
+        std::memcpy(&magic, file.data(), sizeof(magic));
+    if (file.size() < SPIRV_HEADER_SIZE || file.size() % sizeof(uint32_t) != 0 || magic != SPIRV_MAGIC)
+        throw std::runtime_error("Invalid SPIR-V file " + fileName);
+
+    const uint64_t contentHash = hashBytes(file.data(), file.size());
+    auto module = modulesByContent.find(contentHash);
+    if (module != modulesByContent.end() && module->second.codeSize != file.size())
+        throw std::runtime_error("SPIR-V content hash collision for " + fileName);
+
+    if (module == modulesByContent.end())
+    {
+        // Mappings start on a page boundary, the copy only exists for platforms that would ever hand out less
+        VkShaderModule shaderModule;
+        if (reinterpret_cast<uintptr_t>(file.data()) % alignof(uint32_t) == 0)
+        {
+            shaderModule = ShadersMgr::createShaderModule(static_cast<const uint32_t*>(file.data()), file.size());
+        }
+        else
+        {
+            std::vector<uint32_t> code(file.size() / sizeof(uint32_t));
+            std::memcpy(code.data(), file.data(), file.size());
+            shaderModule = ShadersMgr::createShaderModule(code.data(), file.size());
+        }
+        module = modulesByContent.emplace(contentHash, Module{file.size(), shaderModule}).first;
+    }
+
+    return shadersByFile.emplace(fileName, Shader{contentHash, module->second.module}).first->second;
+}
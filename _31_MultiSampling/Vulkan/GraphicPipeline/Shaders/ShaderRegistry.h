@@ -0,0 +1,37 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// Every shader module the application uses, created once from memory mapped SPIR-V and kept until destroyRegistry. Files with
+// identical contents share one module. Only the thread creating pipelines may call in, the modules themselves may be used by
+// pipeline builds on any thread.
+class ShaderRegistry
+{
+public:
+    static VkShaderModule getShaderModule(const std::string& fileName);
+    // Of the SPIR-V words, equal for every file with the same contents
+    static uint64_t getContentHash(const std::string& fileName);
+    // Every pipeline built from the modules has to be created by now
+    static void destroyRegistry();
+
+private:
+    struct Shader
+    {
+        uint64_t contentHash;
+        VkShaderModule module;
+    };
+
+    struct Module
+    {
+        size_t codeSize;
+        VkShaderModule module;
+    };
+
+    static const Shader& loadShader(const std::string& fileName);
+
+    static std::unordered_map<std::string, Shader> shadersByFile;
+    static std::unordered_map<uint64_t, Module> modulesByContent;
+};
@@ -1,32 +1,15 @@
 #include "ShadersMgr.h"
-#include <fstream>
-#include <iostream>
 
-#include "../../LogicalDevicesMgr.h"
-
-std::vector<char> ShadersMgr::readFile(const std::string& fileName)
-{
-    std::ifstream file(fileName, std::ios::ate | std::ios::binary);
-    if (!file.is_open())
-        throw std::runtime_error("Failed to open file " + fileName);
-
-    const size_t fileSize = file.tellg();
-    std::vector<char> buffer(fileSize);
-    file.seekg(0);
-    file.read(buffer.data(), fileSize);
-    file.close();
-    return buffer;
-}
+#include <stdexcept>
 
+#include "../../LogicalDevicesMgr.h"
 
-VkShaderModule ShadersMgr::createShaderModule(const std::string& fileName)
+VkShaderModule ShadersMgr::createShaderModule(const uint32_t* code, size_t codeSize)
 {
-    auto code = readFile(fileName);
-
     VkShaderModuleCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = code.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+    createInfo.codeSize = codeSize;
+    createInfo.pCode = code;
 
     VkShaderModule shaderModule;
     if (vkCreateShaderModule(LogicalDevicesMgr::device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS)
@@ -39,21 +22,3 @@ void ShadersMgr::destroyShaderModule(VkShaderModule shaderModule)
 {
     vkDestroyShaderModule(LogicalDevicesMgr::device, shaderModule, nullptr);
 }
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
@@ -2,34 +2,13 @@
 
 #include <vulkan/vulkan_core.h>
 
-#include <string>
-#include <vector>
+#include <cstddef>
+#include <cstdint>
 
 class ShadersMgr
 {
 public:
-    static VkShaderModule createShaderModule(const std::string& fileName);
+    // code has to be 4 byte aligned, ShaderRegistry loads and validates the files
+    static VkShaderModule createShaderModule(const uint32_t* code, size_t codeSize);
     static void destroyShaderModule(VkShaderModule shaderModule);
-
-private:
-    static std::vector<char> readFile(const std::string& fileName);
 };
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
@@ -0,0 +1,51 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Collects values for layout(constant_id = N) declarations and hands them to a shader stage. getInfo() points into this object,
+// so it has to outlive the pipeline creation that uses it and must not be moved in between.
+class SpecializationConstants
+{
+public:
+    // GLSL bool constants are 32 bit in SPIR-V, so bools are widened to VkBool32
+    template <typename T>
+    void add(uint32_t constantId, T value)
+    {
+        static_assert(std::is_same_v<T, bool> || std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> || std::is_same_v<T, float>,
+                      "specialization constants are bool, int, uint or float");
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            add(constantId, static_cast<VkBool32>(value ? VK_TRUE : VK_FALSE));
+        }
+        else
+        {
+            VkSpecializationMapEntry entry{};
+            entry.constantID = constantId;
+            entry.offset = static_cast<uint32_t>(data.size());
+            entry.size = sizeof(T);
+            entries.push_back(entry);
+
+            data.resize(data.size() + sizeof(T));
+            std::memcpy(data.data() + entry.offset, &value, sizeof(T));
+        }
+    }
+
+    // Constants a stage does not declare are ignored by it, so one set can be shared by every stage of a pipeline
+    const VkSpecializationInfo* getInfo()
+    {
+        info.mapEntryCount = static_cast<uint32_t>(entries.size());
+        info.pMapEntries = entries.data();
+        info.dataSize = data.size();
+        info.pData = data.data();
+        return &info;
+    }
+
+private:
+    std::vector<VkSpecializationMapEntry> entries;
+    std::vector<uint8_t> data;
+    VkSpecializationInfo info{};
+};
@@ -0,0 +1,109 @@
+#include "InstanceBufferMgr.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../LogicalDevicesMgr.h"
+#include "../GraphicPipeline/GraphicsPipelineMgr.h"
+#include "../Memory/MemoryAllocatorMgr.h"
+#include "../Models/ModelsMgr.h"
+#include "../Utils/BufferHelper.h"
+#include "../Utils/ThreadPool.h"
+
+uint32_t InstanceBufferMgr::instanceCount = 1;
+std::vector<VkBuffer> InstanceBufferMgr::instanceBuffers{};
+std::vector<MemoryAllocation> InstanceBufferMgr::instanceBuffersMemory{};
+std::vector<glm::vec3> InstanceBufferMgr::instanceOffsets{glm::vec3(0.0f)};
+float InstanceBufferMgr::gridRadius = 0.0f;
+
+void InstanceBufferMgr::createInstances(uint32_t count)
+{
+    instanceCount = std::max(count, 1u);
+    instanceOffsets.resize(instanceCount);
+
+    const glm::vec3 extent = ModelsMgr::bounds.max - ModelsMgr::bounds.min;
+    const float spacing = std::max(std::max(extent.x, extent.y), 1.0f) * 1.25f;
+    const auto columns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(instanceCount))));
+    const float center = static_cast<float>(columns - 1) * 0.5f;
+
+    for (uint32_t i = 0; i < instanceCount; ++i)
+    {
+        instanceOffsets[i] = glm::vec3((static_cast<float>(i % columns) - center) * spacing,
+                                       (static_cast<float>(i / columns) - center) * spacing, 0.0f);
+    }
+    gridRadius = center * spacing;
+}
+
+void InstanceBufferMgr::createInstanceBuffers()
+{
+    instanceBuffers.resize(GraphicsPipelineMgr::framesInFlight);
+    instanceBuffersMemory.resize(GraphicsPipelineMgr::framesInFlight);
+
+    for (size_t i = 0; i != GraphicsPipelineMgr::framesInFlight; ++i)
+    {
+        const VkDeviceSize bufferSize = sizeof(InstanceData) * instanceCount;
+        BufferHelper::createBuffer(bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                   instanceBuffers[i], instanceBuffersMemory[i]);
+    }
+}
+
+void InstanceBufferMgr::destroyInstanceBuffers()
+{
+    for (size_t i = 0; i != instanceBuffers.size(); ++i)
+    {
+        vkDestroyBuffer(LogicalDevicesMgr::device, instanceBuffers[i], nullptr);
+        MemoryAllocatorMgr::freeMemory(instanceBuffersMemory[i]);
+    }
+    instanceBuffers.clear();
+    instanceBuffersMemory.clear();
+}
+
+void InstanceBufferMgr::updateInstanceBuffer(uint32_t currentFrame)
+{
+    static auto startTime = std::chrono::high_resolution_clock::now();
+    const auto currentTime = std::chrono::high_resolution_clock::now();
+    const float time = std::chrono::duration<float>(currentTime - startTime).count();
+
+    // Every instance spins around its own origin, the phase keeps neighbours apart
+    auto* instances = static_cast<InstanceData*>(instanceBuffersMemory[currentFrame].mappedData);
+    ThreadPool::getShared().parallelFor(instanceCount, 4096, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const float angle = time * glm::radians(90.0f) + static_cast<float>(i) * 0.37f;
+            // The mapping may be write combined, write whole instances and never read them back
+            instances[i].model = glm::rotate(glm::translate(glm::mat4(1.0f), instanceOffsets[i]), angle, glm::vec3(0.0f, 0.0f, 1.0f));
+        }
+    });
+}
+
+VkVertexInputBindingDescription InstanceBufferMgr::getBindingDescription()
+{
+    VkVertexInputBindingDescription bindingDescription = {};
+    bindingDescription.binding = 1;
+    bindingDescription.stride = sizeof(InstanceData);
+    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+    return bindingDescription;
+}
+
+std::array<VkVertexInputAttributeDescription, 4> InstanceBufferMgr::getAttributeDescriptions()
+{
+    std::array<VkVertexInputAttributeDescription, 4> attributeDescriptions = {};
+    for (uint32_t column = 0; column < 4; ++column)
+    {
+        attributeDescriptions[column].binding = 1;
+        attributeDescriptions[column].location = 3 + column;
+        attributeDescriptions[column].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+        attributeDescriptions[column].offset = offsetof(InstanceData, model) + sizeof(glm::vec4) * column;
+    }
+    return attributeDescriptions;
+}
+
+float InstanceBufferMgr::getGridRadius()
+{
+    return gridRadius;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../Memory/MemoryAllocation.h"
+
+// Per instance vertex input, read through binding 1 at VK_VERTEX_INPUT_RATE_INSTANCE
+struct InstanceData
+{
+    glm::mat4 model;
+};
+
+// Every copy of the model is drawn by a single instanced draw. The transforms are rewritten each frame into a persistently
+// mapped buffer owned by that frame in flight, so the CPU never touches memory the GPU may still be reading. CullingMgr reads
+// them as a storage buffer and hands the visible ones to binding 1.
+class InstanceBufferMgr
+{
+public:
+    // Lays the instances out on a grid around the origin, spaced by the model bounds
+    static void createInstances(uint32_t count);
+
+    static void createInstanceBuffers();
+    static void destroyInstanceBuffers();
+
+    static void updateInstanceBuffer(uint32_t currentFrame);
+
+    static VkVertexInputBindingDescription getBindingDescription();
+    // A mat4 takes four consecutive locations, one per column
+    static std::array<VkVertexInputAttributeDescription, 4> getAttributeDescriptions();
+
+    // Half the width of the instance grid, the camera backs off far enough to see all of it
+    static float getGridRadius();
+
+    static uint32_t instanceCount;
+
+    static std::vector<VkBuffer> instanceBuffers;
+    static std::vector<MemoryAllocation> instanceBuffersMemory;
+
+private:
+    static std::vector<glm::vec3> instanceOffsets;
+    static float gridRadius;
+};
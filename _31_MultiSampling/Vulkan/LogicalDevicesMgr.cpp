@@ -3,6 +3,7 @@
 #include <set>
 #include <stdexcept>
 
+#include "GpuTimelineMgr.h"
 #include "ValidationLayerMgr.h"
 #include "QueueFamily/QueueFamilyIndices.h"
 #include "QueueFamily/QueueFamilyMgr.h"
@@ -10,6 +11,9 @@
 VkDevice LogicalDevicesMgr::device = VK_NULL_HANDLE;
 VkQueue LogicalDevicesMgr::graphicsQueue = VK_NULL_HANDLE;
 VkQueue LogicalDevicesMgr::presentQueue = VK_NULL_HANDLE;
+VkQueue LogicalDevicesMgr::transferQueue = VK_NULL_HANDLE;
+uint32_t LogicalDevicesMgr::graphicsQueueFamily = 0;
+uint32_t LogicalDevicesMgr::transferQueueFamily = 0;
 
 void LogicalDevicesMgr::createLogicalDevice()
 {
@@ -17,7 +21,10 @@ void LogicalDevicesMgr::createLogicalDevice()
     const QueueFamilyIndices indices = QueueFamilyMgr::findQueueFamilies(PhysicalDevicesMgr::physicalDevice);
 
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos{};
-    std::set uniqueQueueFamilies = {indices.graphicsFamily.value(), indices.presentFamily.value()};
+    graphicsQueueFamily = indices.graphicsFamily.value();
+    transferQueueFamily = indices.transferFamily.value_or(graphicsQueueFamily);
+
+    std::set uniqueQueueFamilies = {graphicsQueueFamily, indices.presentFamily.value(), transferQueueFamily};
     for (uint32_t queueFamily : uniqueQueueFamilies)
     {
 
@@ -33,13 +40,23 @@ void LogicalDevicesMgr::createLogicalDevice()
     deviceFeatures.samplerAnisotropy = VK_TRUE;
     deviceFeatures.sampleRateShading = VK_TRUE;
 
+    std::vector<const char*> extensions = PhysicalDevicesMgr::deviceExtensions;
+    GpuTimelineMgr::selectBackend(PhysicalDevicesMgr::physicalDevice);
+    if (GpuTimelineMgr::backend == TimelineBackend::KhrTimelineSemaphore)
+        extensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+
+    VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures{};
+    timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+    timelineFeatures.timelineSemaphore = VK_TRUE;
+
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    createInfo.pNext = GpuTimelineMgr::backend != TimelineBackend::Fences ? &timelineFeatures : nullptr;
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pEnabledFeatures = &deviceFeatures;
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(PhysicalDevicesMgr::deviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = PhysicalDevicesMgr::deviceExtensions.data();
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.data();
 
     if (vkCreateDevice(PhysicalDevicesMgr::physicalDevice, &createInfo, nullptr, &device) != VK_SUCCESS)
     {
@@ -48,6 +65,7 @@ void LogicalDevicesMgr::createLogicalDevice()
 
     vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &graphicsQueue);
     vkGetDeviceQueue(device, indices.presentFamily.value(), 0, &presentQueue);
+    vkGetDeviceQueue(device, transferQueueFamily, 0, &transferQueue);
 }
 
 void LogicalDevicesMgr::destroyLogicalDevice()
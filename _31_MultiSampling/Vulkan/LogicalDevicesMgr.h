@@ -9,6 +9,12 @@ public:
     static VkDevice device;
     static VkQueue graphicsQueue;
     static VkQueue presentQueue;
+
+    // Falls back to the graphics queue when the device has no separate transfer family
+    static VkQueue transferQueue;
+    static uint32_t graphicsQueueFamily;
+    static uint32_t transferQueueFamily;
+    static bool hasDedicatedTransferQueue() { return transferQueueFamily != graphicsQueueFamily; }
 };
 
 
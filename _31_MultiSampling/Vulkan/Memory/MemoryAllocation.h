@@ -0,0 +1,35 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+
+// Buffers and linear images never share a block with optimal images, so bufferImageGranularity padding is never needed
+enum class MemoryResourceKind
+{
+    Linear,
+    Optimal
+};
+
+struct MemoryAllocation
+{
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+    void* mappedData = nullptr; // Only set for host visible memory, the whole block stays mapped
+    uint32_t memoryTypeIndex = 0;
+    uint32_t poolIndex = 0;
+    uint32_t blockIndex = 0;
+    uint32_t node = 0;
+};
+
+struct MemoryTypeStats
+{
+    uint32_t memoryTypeIndex = 0;
+    uint32_t blockCount = 0;
+    uint32_t allocationCount = 0;
+    VkDeviceSize blockBytes = 0;
+    VkDeviceSize usedBytes = 0;
+    VkDeviceSize largestFreeRange = 0; // Largest in any one block
+    // Per block 1 - largestFreeRange / freeBytes, weighted by free bytes. 0 means every block's free space is contiguous
+    float fragmentation = 0.0f;
+};
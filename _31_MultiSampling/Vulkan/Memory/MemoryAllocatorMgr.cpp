@@ -0,0 +1,252 @@
+#include "MemoryAllocatorMgr.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#include "../LogicalDevicesMgr.h"
+#include "../PhysicalDevicesMgr.h"
+#include "../Utils/BufferHelper.h"
+
+VkDeviceSize MemoryAllocatorMgr::preferredBlockSize = 64ull * 1024 * 1024;
+VkPhysicalDeviceMemoryProperties MemoryAllocatorMgr::memoryProperties{};
+VkDeviceSize MemoryAllocatorMgr::bufferImageGranularity = 1;
+std::vector<MemoryAllocatorMgr::MemoryPool> MemoryAllocatorMgr::pools{};
+
+void MemoryAllocatorMgr::createAllocator()
+{
+    vkGetPhysicalDeviceMemoryProperties(PhysicalDevicesMgr::physicalDevice, &memoryProperties);
+
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(PhysicalDevicesMgr::physicalDevice, &deviceProperties);
+    bufferImageGranularity = deviceProperties.limits.bufferImageGranularity;
+
+    // Two pools per memory type, one for linear and one for optimal resources
+    pools.resize(memoryProperties.memoryTypeCount * 2);
+    for (uint32_t i = 0; i < pools.size(); ++i)
+        pools[i].memoryTypeIndex = i / 2;
+}
+
+void MemoryAllocatorMgr::destroyAllocator()
+{
+    for (auto& pool : pools)
+    {
+        for (auto& block : pool.blocks)
+        {
+            if (block.memory == VK_NULL_HANDLE)
+                continue;
+
+            if (block.allocator == nullptr || !block.allocator->isEmpty())
+                std::cerr << "memory allocator: leaked allocation in memory type " << pool.memoryTypeIndex << '\n';
+            destroyBlock(block);
+        }
+    }
+
+    pools.clear();
+}
+
+uint32_t MemoryAllocatorMgr::getPoolIndex(uint32_t memoryTypeIndex, MemoryResourceKind kind)
+{
+    // When the granularity is 1 linear and optimal resources can safely be neighbours
+    if (bufferImageGranularity <= 1)
+        kind = MemoryResourceKind::Linear;
+    return memoryTypeIndex * 2 + (kind == MemoryResourceKind::Optimal ? 1 : 0);
+}
+
+VkDeviceSize MemoryAllocatorMgr::getBlockSize(uint32_t memoryTypeIndex)
+{
+    // Small heaps (e.g. the 256MB BAR heap) would be exhausted by a handful of full sized blocks
+    const VkDeviceSize heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[memoryTypeIndex].heapIndex].size;
+    constexpr VkDeviceSize smallHeapLimit = 1024ull * 1024 * 1024;
+    return heapSize <= smallHeapLimit ? std::min(preferredBlockSize, heapSize / 8) : preferredBlockSize;
+}
+
+uint32_t MemoryAllocatorMgr::createBlock(MemoryPool& pool, VkDeviceSize size, bool dedicated)
+{
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = size;
+    allocInfo.memoryTypeIndex = pool.memoryTypeIndex;
+
+    MemoryBlock block;
+    if (vkAllocateMemory(LogicalDevicesMgr::device, &allocInfo, nullptr, &block.memory) != VK_SUCCESS)
+        return UINT32_MAX;
+
+    block.size = size;
+    if (memoryProperties.memoryTypes[pool.memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+        vkMapMemory(LogicalDevicesMgr::device, block.memory, 0, size, 0, &block.mappedData);
+
+    if (!dedicated)
+        block.allocator = std::make_unique<TlsfAllocator>(size);
+
+    const auto freeSlot = std::find_if(pool.blocks.begin(), pool.blocks.end(),
+                                       [](const MemoryBlock& candidate) { return candidate.memory == VK_NULL_HANDLE; });
+    if (freeSlot != pool.blocks.end())
+    {
+        *freeSlot = std::move(block);
+        return static_cast<uint32_t>(freeSlot - pool.blocks.begin());
+    }
+
+    pool.blocks.push_back(std::move(block));
+    return static_cast<uint32_t>(pool.blocks.size() - 1);
+}
+
+void MemoryAllocatorMgr::destroyBlock(MemoryBlock& block)
+{
+    if (block.mappedData != nullptr)
+        vkUnmapMemory(LogicalDevicesMgr::device, block.memory);
+    vkFreeMemory(LogicalDevicesMgr::device, block.memory, nullptr);
+    block = MemoryBlock{};
+}
+
+MemoryAllocation MemoryAllocatorMgr::allocateMemory(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                                                    MemoryResourceKind kind)
+{
+    MemoryAllocation allocation;
+    allocation.memoryTypeIndex = BufferHelper::findSuitableMemoryType(requirements.memoryTypeBits, properties);
+    allocation.poolIndex = getPoolIndex(allocation.memoryTypeIndex, kind);
+    allocation.size = requirements.size;
+
+    MemoryPool& pool = pools[allocation.poolIndex];
+    const VkDeviceSize blockSize = getBlockSize(allocation.memoryTypeIndex);
+
+    // Large resources get their own VkDeviceMemory instead of fragmenting the shared blocks
+    uint32_t blockIndex = UINT32_MAX;
+    if (requirements.size <= blockSize / 2)
+    {
+        for (uint32_t i = 0; i < pool.blocks.size(); ++i)
+        {
+            MemoryBlock& block = pool.blocks[i];
+            if (block.memory == VK_NULL_HANDLE || block.allocator == nullptr)
+                continue;
+
+            uint64_t offset = 0;
+            const uint32_t node = block.allocator->allocate(requirements.size, requirements.alignment, offset);
+            if (node != TlsfAllocator::INVALID_NODE)
+            {
+                blockIndex = i;
+                allocation.node = node;
+                allocation.offset = offset;
+                break;
+            }
+        }
+
+        if (blockIndex == UINT32_MAX)
+        {
+            blockIndex = createBlock(pool, blockSize, false);
+            if (blockIndex != UINT32_MAX)
+            {
+                uint64_t offset = 0;
+                allocation.node = pool.blocks[blockIndex].allocator->allocate(requirements.size, requirements.alignment, offset);
+                allocation.offset = offset;
+            }
+        }
+    }
+
+    // Either the resource is large or the heap could not fit a full block, fall back to an exact sized allocation
+    if (blockIndex == UINT32_MAX)
+    {
+        blockIndex = createBlock(pool, requirements.size, true);
+        if (blockIndex == UINT32_MAX)
+            throw std::runtime_error("failed to allocate device memory!");
+        allocation.offset = 0;
+    }
+
+    const MemoryBlock& block = pool.blocks[blockIndex];
+    allocation.blockIndex = blockIndex;
+    allocation.memory = block.memory;
+    if (block.mappedData != nullptr)
+        allocation.mappedData = static_cast<char*>(block.mappedData) + allocation.offset;
+
+    return allocation;
+}
+
+void MemoryAllocatorMgr::freeMemory(MemoryAllocation& allocation)
+{
+    if (allocation.memory == VK_NULL_HANDLE)
+        return;
+
+    MemoryPool& pool = pools[allocation.poolIndex];
+    MemoryBlock& block = pool.blocks[allocation.blockIndex];
+
+    if (block.allocator == nullptr)
+    {
+        destroyBlock(block);
+    }
+    else
+    {
+        block.allocator->free(allocation.node);
+
+        // Keep one empty block around per pool so that create/destroy cycles do not hit vkAllocateMemory every time
+        if (block.allocator->isEmpty())
+        {
+            const auto otherBlocks = std::count_if(pool.blocks.begin(), pool.blocks.end(), [](const MemoryBlock& candidate)
+            {
+                return candidate.memory != VK_NULL_HANDLE && candidate.allocator != nullptr;
+            });
+            if (otherBlocks > 1)
+                destroyBlock(block);
+        }
+    }
+
+    allocation = MemoryAllocation{};
+}
+
+std::vector<MemoryTypeStats> MemoryAllocatorMgr::getStats()
+{
+    std::vector<MemoryTypeStats> stats(memoryProperties.memoryTypeCount);
+    for (uint32_t i = 0; i < stats.size(); ++i)
+        stats[i].memoryTypeIndex = i;
+    // Free bytes outside the largest free range of their own block, a range never spans two blocks
+    std::vector<VkDeviceSize> strandedBytes(stats.size(), 0);
+
+    for (const auto& pool : pools)
+    {
+        MemoryTypeStats& typeStats = stats[pool.memoryTypeIndex];
+        for (const auto& block : pool.blocks)
+        {
+            if (block.memory == VK_NULL_HANDLE)
+                continue;
+
+            ++typeStats.blockCount;
+            typeStats.blockBytes += block.size;
+            if (block.allocator == nullptr)
+            {
+                ++typeStats.allocationCount;
+                typeStats.usedBytes += block.size;
+                continue;
+            }
+
+            typeStats.allocationCount += block.allocator->getAllocationCount();
+            typeStats.usedBytes += block.allocator->getUsedSize();
+            const VkDeviceSize largestFreeRange = block.allocator->getLargestFreeRange();
+            typeStats.largestFreeRange = std::max(typeStats.largestFreeRange, largestFreeRange);
+            strandedBytes[pool.memoryTypeIndex] += block.size - block.allocator->getUsedSize() - largestFreeRange;
+        }
+    }
+
+    // Per block fragmentation weighted by the block's free bytes, which sums to stranded / free over the whole type
+    for (auto& typeStats : stats)
+    {
+        const VkDeviceSize freeBytes = typeStats.blockBytes - typeStats.usedBytes;
+        typeStats.fragmentation = freeBytes > 0
+            ? static_cast<float>(strandedBytes[typeStats.memoryTypeIndex]) / static_cast<float>(freeBytes)
+            : 0.0f;
+    }
+
+    stats.erase(std::remove_if(stats.begin(), stats.end(), [](const MemoryTypeStats& typeStats) { return typeStats.blockCount == 0; }),
+                stats.end());
+
+    return stats;
+}
+
+void MemoryAllocatorMgr::printStats()
+{
+    std::cout << "device memory:\n";
+    for (const auto& typeStats : getStats())
+    {
+        std::cout << "\ttype " << typeStats.memoryTypeIndex << ": " << typeStats.blockCount << " blocks, " << typeStats.allocationCount
+            << " allocations, " << typeStats.usedBytes << " / " << typeStats.blockBytes << " bytes used, fragmentation "
+            << typeStats.fragmentation << '\n';
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <memory>
+#include <vector>
+
+#include "MemoryAllocation.h"
+#include "TlsfAllocator.h"
+
+class MemoryAllocatorMgr
+{
+public:
+    static void createAllocator();
+    static void destroyAllocator();
+
+    static MemoryAllocation allocateMemory(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, MemoryResourceKind kind);
+    static void freeMemory(MemoryAllocation& allocation);
+
+    static std::vector<MemoryTypeStats> getStats();
+    static void printStats();
+
+    static VkDeviceSize preferredBlockSize;
+
+private:
+    struct MemoryBlock
+    {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        void* mappedData = nullptr;
+        std::unique_ptr<TlsfAllocator> allocator; // Null for dedicated blocks, which hold exactly one allocation
+    };
+
+    struct MemoryPool
+    {
+        uint32_t memoryTypeIndex = 0;
+        std::vector<MemoryBlock> blocks;
+    };
+
+    static uint32_t getPoolIndex(uint32_t memoryTypeIndex, MemoryResourceKind kind);
+    static VkDeviceSize getBlockSize(uint32_t memoryTypeIndex);
+    static uint32_t createBlock(MemoryPool& pool, VkDeviceSize size, bool dedicated);
+    static void destroyBlock(MemoryBlock& block);
+
+    static VkPhysicalDeviceMemoryProperties memoryProperties;
+    static VkDeviceSize bufferImageGranularity;
+    static std::vector<MemoryPool> pools;
+};
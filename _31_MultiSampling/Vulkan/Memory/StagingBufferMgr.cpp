@@ -0,0 +1,113 @@
+#include "StagingBufferMgr.h"
+
+#include "MemoryAllocatorMgr.h"
+#include "../LogicalDevicesMgr.h"
+#include "../CommandBuffers/CommandBuffersMgr.h"
+#include "../Utils/BufferHelper.h"
+
+VkDeviceSize StagingBufferMgr::ringSize = 32ull * 1024 * 1024;
+VkBuffer StagingBufferMgr::buffer = VK_NULL_HANDLE;
+MemoryAllocation StagingBufferMgr::bufferMemory{};
+uint64_t StagingBufferMgr::head = 0;
+uint64_t StagingBufferMgr::tail = 0;
+std::deque<StagingBufferMgr::RetiredRange> StagingBufferMgr::retiredRanges{};
+std::deque<StagingBufferMgr::OversizedBuffer> StagingBufferMgr::oversizedBuffers{};
+
+void StagingBufferMgr::createStagingBuffer()
+{
+    BufferHelper::createBuffer(ringSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, buffer, bufferMemory);
+    head = 0;
+    tail = 0;
+}
+
+void StagingBufferMgr::destroyStagingBuffer()
+{
+    retire();
+    CommandBuffersMgr::waitForSerial(CommandBuffersMgr::getLastSubmittedSerial());
+    reclaim(CommandBuffersMgr::pollCompletedSerial());
+
+    vkDestroyBuffer(LogicalDevicesMgr::device, buffer, nullptr);
+    MemoryAllocatorMgr::freeMemory(bufferMemory);
+}
+
+StagingRegion StagingBufferMgr::allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+    reclaim(CommandBuffersMgr::pollCompletedSerial());
+
+    if (size > ringSize)
+        return allocateOversized(size);
+
+    uint64_t offset = 0;
+    uint64_t required = 0;
+    while (true)
+    {
+        const uint64_t position = head % ringSize;
+        offset = (position + alignment - 1) / alignment * alignment;
+        // Never let a region straddle the end of the ring, skip the remaining bytes and start over at zero instead
+        if (offset + size > ringSize)
+            offset = 0;
+
+        required = (offset >= position ? offset - position : ringSize - position) + size;
+        if (head + required - tail <= ringSize)
+            break;
+
+        // Everything in flight has been handed back already, the ring is filled by regions that have not been submitted yet
+        if (retiredRanges.empty())
+            return allocateOversized(size);
+
+        CommandBuffersMgr::waitForSerial(retiredRanges.front().serial);
+        reclaim(CommandBuffersMgr::pollCompletedSerial());
+    }
+
+    head += required;
+
+    StagingRegion region;
+    region.buffer = buffer;
+    region.offset = offset;
+    region.mappedData = static_cast<char*>(bufferMemory.mappedData) + offset;
+    return region;
+}
+
+StagingRegion StagingBufferMgr::allocateOversized(VkDeviceSize size)
+{
+    OversizedBuffer oversized{};
+    BufferHelper::createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                               oversized.buffer, oversized.memory);
+    oversizedBuffers.push_back(oversized);
+
+    StagingRegion region;
+    region.buffer = oversized.buffer;
+    region.offset = 0;
+    region.mappedData = oversized.memory.mappedData;
+    return region;
+}
+
+void StagingBufferMgr::retire()
+{
+    const uint64_t serial = CommandBuffersMgr::getLastSubmittedSerial();
+
+    const uint64_t retiredHead = retiredRanges.empty() ? tail : retiredRanges.back().head;
+    if (head != retiredHead)
+        retiredRanges.push_back({serial, head});
+
+    for (auto it = oversizedBuffers.rbegin(); it != oversizedBuffers.rend() && it->serial == 0; ++it)
+        it->serial = serial;
+}
+
+void StagingBufferMgr::reclaim(uint64_t completedSerial)
+{
+    while (!retiredRanges.empty() && retiredRanges.front().serial <= completedSerial)
+    {
+        tail = retiredRanges.front().head;
+        retiredRanges.pop_front();
+    }
+
+    while (!oversizedBuffers.empty() && oversizedBuffers.front().serial != 0 && oversizedBuffers.front().serial <= completedSerial)
+    {
+        vkDestroyBuffer(LogicalDevicesMgr::device, oversizedBuffers.front().buffer, nullptr);
+        MemoryAllocatorMgr::freeMemory(oversizedBuffers.front().memory);
+        oversizedBuffers.pop_front();
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <deque>
+
+#include "MemoryAllocation.h"
+
+struct StagingRegion
+{
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    void* mappedData = nullptr;
+};
+
+// One persistently mapped ring that all uploads copy their source data into. Space is handed out in submission order and
+// reclaimed once the submission serial that consumed it has completed.
+class StagingBufferMgr
+{
+public:
+    static void createStagingBuffer();
+    static void destroyStagingBuffer();
+
+    static StagingRegion allocate(VkDeviceSize size, VkDeviceSize alignment = 16);
+    // Hands every region allocated since the last call to the most recent submission, call it after submitting the copies
+    static void retire();
+
+    // Set it before createStagingBuffer, --staging-ring-mb overrides the 32 MB default
+    static VkDeviceSize ringSize;
+
+private:
+    struct RetiredRange
+    {
+        uint64_t serial;
+        uint64_t head;
+    };
+
+    // Requests that cannot fit into the ring get their own buffer, released the same way as ring space
+    struct OversizedBuffer
+    {
+        uint64_t serial;
+        VkBuffer buffer;
+        MemoryAllocation memory;
+    };
+
+    static void reclaim(uint64_t completedSerial);
+    static StagingRegion allocateOversized(VkDeviceSize size);
+
+    static VkBuffer buffer;
+    static MemoryAllocation bufferMemory;
+
+    // Monotonic byte positions, the physical offset is position % ringSize
+    static uint64_t head;
+    static uint64_t tail;
+    static std::deque<RetiredRange> retiredRanges;
+    static std::deque<OversizedBuffer> oversizedBuffers;
+};
@@ -0,0 +1,243 @@
+#include "TlsfAllocator.h"
+
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+uint32_t findLowestBit(uint64_t value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<uint32_t>(index);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+}
+
+uint32_t findHighestBit(uint64_t value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<uint32_t>(index);
+#else
+    return static_cast<uint32_t>(63 - __builtin_clzll(value));
+#endif
+}
+
+uint64_t alignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+}
+
+TlsfAllocator::TlsfAllocator(uint64_t size) : size(size)
+{
+    for (auto& heads : freeHeads)
+        std::fill(std::begin(heads), std::end(heads), INVALID_NODE);
+
+    const uint32_t node = createNode();
+    nodes[node].offset = 0;
+    nodes[node].size = size;
+    insertFreeNode(node);
+}
+
+void TlsfAllocator::mapping(uint64_t size, uint32_t& fl, uint32_t& sl)
+{
+    if (size < SMALL_SIZE)
+    {
+        fl = 0;
+        sl = static_cast<uint32_t>(size / (SMALL_SIZE / SL_COUNT));
+        return;
+    }
+
+    const uint32_t highestBit = findHighestBit(size);
+    fl = highestBit - SMALL_SIZE_BITS + 1;
+    sl = static_cast<uint32_t>(size >> (highestBit - SL_BITS)) & (SL_COUNT - 1);
+}
+
+uint32_t TlsfAllocator::findFreeNode(uint64_t size) const
+{
+    // Round up to the next list boundary so that every node of the list we land on is large enough
+    if (size < SMALL_SIZE)
+        size = alignUp(size, SMALL_SIZE / SL_COUNT);
+    else
+        size += (1ull << (findHighestBit(size) - SL_BITS)) - 1;
+
+    uint32_t fl, sl;
+    mapping(size, fl, sl);
+    if (fl >= FL_COUNT)
+        return INVALID_NODE;
+
+    uint32_t slMap = sl < SL_COUNT ? slBitmap[fl] & (~0u << sl) : 0;
+    if (slMap == 0)
+    {
+        const uint64_t flMap = fl + 1 < 64 ? flBitmap & (~0ull << (fl + 1)) : 0;
+        if (flMap == 0)
+            return INVALID_NODE;
+
+        fl = findLowestBit(flMap);
+        slMap = slBitmap[fl];
+    }
+
+    return freeHeads[fl][findLowestBit(slMap)];
+}
+
+uint32_t TlsfAllocator::allocate(uint64_t size, uint64_t alignment, uint64_t& offset)
+{
+    size = std::max<uint64_t>(size, 1);
+    alignment = std::max<uint64_t>(alignment, 1);
+
+    // Most free ranges start aligned already, so only pay for the worst case padding when the cheap lookup misses
+    uint32_t node = findFreeNode(size);
+    if (node == INVALID_NODE || alignUp(nodes[node].offset, alignment) + size > nodes[node].offset + nodes[node].size)
+        node = findFreeNode(size + alignment - 1);
+    if (node == INVALID_NODE)
+        return INVALID_NODE;
+
+    removeFreeNode(node);
+
+    const uint64_t padding = alignUp(nodes[node].offset, alignment) - nodes[node].offset;
+    if (padding > 0)
+    {
+        const uint32_t paddingNode = createNode();
+        nodes[paddingNode].offset = nodes[node].offset;
+        nodes[paddingNode].size = padding;
+        nodes[paddingNode].prevPhysical = nodes[node].prevPhysical;
+        nodes[paddingNode].nextPhysical = node;
+        if (nodes[paddingNode].prevPhysical != INVALID_NODE)
+            nodes[nodes[paddingNode].prevPhysical].nextPhysical = paddingNode;
+        nodes[node].prevPhysical = paddingNode;
+        nodes[node].offset += padding;
+        nodes[node].size -= padding;
+        insertFreeNode(paddingNode);
+    }
+
+    if (nodes[node].size > size)
+    {
+        const uint32_t remainderNode = createNode();
+        nodes[remainderNode].offset = nodes[node].offset + size;
+        nodes[remainderNode].size = nodes[node].size - size;
+        nodes[remainderNode].prevPhysical = node;
+        nodes[remainderNode].nextPhysical = nodes[node].nextPhysical;
+        if (nodes[remainderNode].nextPhysical != INVALID_NODE)
+            nodes[nodes[remainderNode].nextPhysical].prevPhysical = remainderNode;
+        nodes[node].nextPhysical = remainderNode;
+        nodes[node].size = size;
+        insertFreeNode(remainderNode);
+    }
+
+    usedSize += nodes[node].size;
+    ++allocationCount;
+    offset = nodes[node].offset;
+    return node;
+}
+
+void TlsfAllocator::free(uint32_t node)
+{
+    usedSize -= nodes[node].size;
+    --allocationCount;
+
+    const uint32_t prev = nodes[node].prevPhysical;
+    if (prev != INVALID_NODE && nodes[prev].free)
+    {
+        removeFreeNode(prev);
+        nodes[node].offset = nodes[prev].offset;
+        nodes[node].size += nodes[prev].size;
+        nodes[node].prevPhysical = nodes[prev].prevPhysical;
+        if (nodes[node].prevPhysical != INVALID_NODE)
+            nodes[nodes[node].prevPhysical].nextPhysical = node;
+        releaseNode(prev);
+    }
+
+    const uint32_t next = nodes[node].nextPhysical;
+    if (next != INVALID_NODE && nodes[next].free)
+    {
+        removeFreeNode(next);
+        nodes[node].size += nodes[next].size;
+        nodes[node].nextPhysical = nodes[next].nextPhysical;
+        if (nodes[node].nextPhysical != INVALID_NODE)
+            nodes[nodes[node].nextPhysical].prevPhysical = node;
+        releaseNode(next);
+    }
+
+    insertFreeNode(node);
+}
+
+uint64_t TlsfAllocator::getLargestFreeRange() const
+{
+    if (flBitmap == 0)
+        return 0;
+
+    const uint32_t fl = findHighestBit(flBitmap);
+    const uint32_t sl = findHighestBit(slBitmap[fl]);
+
+    uint64_t largest = 0;
+    for (uint32_t node = freeHeads[fl][sl]; node != INVALID_NODE; node = nodes[node].nextFree)
+        largest = std::max(largest, nodes[node].size);
+    return largest;
+}
+
+uint32_t TlsfAllocator::createNode()
+{
+    if (!unusedNodes.empty())
+    {
+        const uint32_t node = unusedNodes.back();
+        unusedNodes.pop_back();
+        nodes[node] = Node{};
+        return node;
+    }
+
+    nodes.emplace_back();
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void TlsfAllocator::releaseNode(uint32_t node)
+{
+    unusedNodes.push_back(node);
+}
+
+void TlsfAllocator::insertFreeNode(uint32_t node)
+{
+    uint32_t fl, sl;
+    mapping(nodes[node].size, fl, sl);
+
+    nodes[node].free = true;
+    nodes[node].prevFree = INVALID_NODE;
+    nodes[node].nextFree = freeHeads[fl][sl];
+    if (freeHeads[fl][sl] != INVALID_NODE)
+        nodes[freeHeads[fl][sl]].prevFree = node;
+    freeHeads[fl][sl] = node;
+
+    flBitmap |= 1ull << fl;
+    slBitmap[fl] |= 1u << sl;
+}
+
+void TlsfAllocator::removeFreeNode(uint32_t node)
+{
+    uint32_t fl, sl;
+    mapping(nodes[node].size, fl, sl);
+
+    if (nodes[node].prevFree != INVALID_NODE)
+        nodes[nodes[node].prevFree].nextFree = nodes[node].nextFree;
+    else
+        freeHeads[fl][sl] = nodes[node].nextFree;
+    if (nodes[node].nextFree != INVALID_NODE)
+        nodes[nodes[node].nextFree].prevFree = nodes[node].prevFree;
+
+    nodes[node].free = false;
+    nodes[node].prevFree = INVALID_NODE;
+    nodes[node].nextFree = INVALID_NODE;
+
+    if (freeHeads[fl][sl] == INVALID_NODE)
+    {
+        slBitmap[fl] &= ~(1u << sl);
+        if (slBitmap[fl] == 0)
+            flBitmap &= ~(1ull << fl);
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Two-level segregated fit allocator over an abstract [0, size) range. It only hands out offsets, so the same
+// placement logic serves device memory blocks and ranges inside large buffers.
+class TlsfAllocator
+{
+public:
+    static constexpr uint32_t INVALID_NODE = UINT32_MAX;
+
+    explicit TlsfAllocator(uint64_t size);
+
+    // Returns INVALID_NODE when no free range can hold size bytes at the requested alignment
+    uint32_t allocate(uint64_t size, uint64_t alignment, uint64_t& offset);
+    void free(uint32_t node);
+
+    uint64_t getSize() const { return size; }
+    uint64_t getUsedSize() const { return usedSize; }
+    uint32_t getAllocationCount() const { return allocationCount; }
+    uint64_t getLargestFreeRange() const;
+    bool isEmpty() const { return allocationCount == 0; }
+
+private:
+    static constexpr uint32_t SL_BITS = 4;
+    static constexpr uint32_t SL_COUNT = 1u << SL_BITS;
+    static constexpr uint32_t SMALL_SIZE_BITS = 8;
+    static constexpr uint64_t SMALL_SIZE = 1ull << SMALL_SIZE_BITS;
+    static constexpr uint32_t FL_COUNT = 64 - SMALL_SIZE_BITS + 1;
+
+    struct Node
+    {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint32_t prevPhysical = INVALID_NODE;
+        uint32_t nextPhysical = INVALID_NODE;
+        uint32_t prevFree = INVALID_NODE;
+        uint32_t nextFree = INVALID_NODE;
+        bool free = false;
+    };
+
+    static void mapping(uint64_t size, uint32_t& fl, uint32_t& sl);
+    uint32_t findFreeNode(uint64_t size) const;
+    uint32_t createNode();
+    void releaseNode(uint32_t node);
+    void insertFreeNode(uint32_t node);
+    void removeFreeNode(uint32_t node);
+
+    uint64_t size = 0;
+    uint64_t usedSize = 0;
+    uint32_t allocationCount = 0;
+
+    uint64_t flBitmap = 0;
+    uint32_t slBitmap[FL_COUNT] = {};
+    uint32_t freeHeads[FL_COUNT][SL_COUNT];
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> unusedNodes;
+};
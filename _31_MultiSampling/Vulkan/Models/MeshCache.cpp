@@ -0,0 +1,83 @@
+#include "MeshCache.h"
+
+#include <cstring>
+#include <iostream>
+
+#include "../Utils/FileHelper.h"
+#include "../Utils/Hash.h"
+
+namespace
+{
+constexpr char MAGIC[4] = {'V', 'K', 'M', 'C'};
+}
+
+std::string MeshCache::getCachePath(const std::string& sourcePath)
+{
+    return sourcePath + ".meshcache";
+}
+
+uint64_t MeshCache::hashFile(const std::string& path)
+{
+    MappedFile file;
+    if (!file.open(path))
+        return 0;
+
+    return hashBytes(file.data(), file.size());
+}
+
+bool MeshCache::load(const std::string& cachePath, uint64_t sourceHash, MappedFile& file, MeshCacheView& mesh)
+{
+    if (!file.open(cachePath))
+        return false;
+
+    Header header;
+    if (file.size() < sizeof(Header))
+    {
+        file.close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(Header));
+
+    const uint64_t expectedSize = sizeof(Header) + static_cast<uint64_t>(header.vertexCount) * sizeof(Vertex) +
+        static_cast<uint64_t>(header.indexCount) * sizeof(uint32_t);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.vertexStride != sizeof(Vertex) ||
+        header.sourceHash != sourceHash || expectedSize != file.size())
+    {
+        file.close();
+        return false;
+    }
+
+    const char* base = static_cast<const char*>(file.data());
+    mesh.vertices = reinterpret_cast<const Vertex*>(base + sizeof(Header));
+    mesh.vertexCount = header.vertexCount;
+    mesh.indices = reinterpret_cast<const uint32_t*>(base + sizeof(Header) + header.vertexCount * sizeof(Vertex));
+    mesh.indexCount = header.indexCount;
+    mesh.bounds.min = {header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]};
+    mesh.bounds.max = {header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]};
+    return true;
+}
+
+void MeshCache::write(const std::string& cachePath, uint64_t sourceHash, const Vertex* vertices, uint32_t vertexCount,
+                      const uint32_t* indices, uint32_t indexCount, const MeshBounds& bounds)
+{
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.sourceHash = sourceHash;
+    header.vertexStride = sizeof(Vertex);
+    header.vertexCount = vertexCount;
+    header.indexCount = indexCount;
+    for (int i = 0; i < 3; ++i)
+    {
+        header.boundsMin[i] = bounds.min[i];
+        header.boundsMax[i] = bounds.max[i];
+    }
+
+    std::string error;
+    if (!FileHelper::writeFileAtomically(cachePath,
+                                         {{&header, sizeof(header)},
+                                          {vertices, vertexCount * sizeof(Vertex)},
+                                          {indices, indexCount * sizeof(uint32_t)}},
+                                         error))
+        std::cerr << "mesh cache: cannot write " << cachePath << ": " << error << '\n';
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include <glm/glm.hpp>
+
+#include "../Utils/MappedFile.h"
+#include "../Vertex/Vertex.h"
+
+struct MeshBounds
+{
+    glm::vec3 min{0.0f};
+    glm::vec3 max{0.0f};
+};
+
+// Points into the memory mapped cache file, only valid while the MappedFile it was loaded from stays open
+struct MeshCacheView
+{
+    const Vertex* vertices = nullptr;
+    uint32_t vertexCount = 0;
+    const uint32_t* indices = nullptr;
+    uint32_t indexCount = 0;
+    MeshBounds bounds;
+};
+
+// Binary dump of the final, deduplicated vertex and index arrays of one source model. The file is laid out so the arrays can
+// be copied straight out of the mapping: a fixed header, the Vertex array, then the index array.
+class MeshCache
+{
+public:
+    // Bump whenever the layout of the file or of Vertex changes, or loading starts producing different arrays
+    static constexpr uint32_t VERSION = 3;
+
+    static std::string getCachePath(const std::string& sourcePath);
+    // FNV-1a over the source file, the cache is only used when it was built from identical bytes
+    static uint64_t hashFile(const std::string& path);
+
+    static bool load(const std::string& cachePath, uint64_t sourceHash, MappedFile& file, MeshCacheView& mesh);
+    static void write(const std::string& cachePath, uint64_t sourceHash, const Vertex* vertices, uint32_t vertexCount,
+                      const uint32_t* indices, uint32_t indexCount, const MeshBounds& bounds);
+
+private:
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t sourceHash;
+        uint32_t vertexStride;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t reserved;
+        float boundsMin[3];
+        float boundsMax[3];
+        uint64_t padding; // Pads the header to 64 bytes so the vertex array starts aligned
+    };
+    static_assert(sizeof(Header) == 64, "mesh cache header layout changed");
+};
@@ -0,0 +1,234 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <iostream>
+
+uint32_t MeshOptimizer::cacheSize = 16;
+
+void MeshOptimizer::optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+    const auto vertexCount = static_cast<uint32_t>(vertices.size());
+    const VertexCacheStatistics before = analyzeVertexCache(indices, vertexCount, cacheSize);
+
+    std::vector<uint32_t> clusters;
+    optimizeVertexCache(indices, vertexCount, &clusters);
+    optimizeOverdraw(indices, vertices, clusters);
+    optimizeVertexFetch(vertices, indices);
+
+    const VertexCacheStatistics after = analyzeVertexCache(indices, static_cast<uint32_t>(vertices.size()), cacheSize);
+    std::cout << "vertex cache (" << cacheSize << " entries): ACMR " << before.acmr << " -> " << after.acmr << ", ATVR "
+        << before.atvr << " -> " << after.atvr << '\n';
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>* clusters)
+{
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    // Vertex to triangle adjacency, offsets[v] .. offsets[v + 1] index into adjacency
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (uint32_t index : indices)
+        ++liveTriangles[index];
+
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+        offsets[vertex + 1] = offsets[vertex] + liveTriangles[vertex];
+
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+    {
+        for (size_t corner = 0; corner < 3; ++corner)
+            adjacency[fill[indices[triangle * 3 + corner]]++] = static_cast<uint32_t>(triangle);
+    }
+
+    std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnds;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+
+    uint32_t timestamp = cacheSize + 1;
+    uint32_t scanCursor = 0;
+    const auto inCache = [&](uint32_t vertex) { return timestamp - cacheTimestamps[vertex] <= cacheSize; };
+
+    uint32_t fanningVertex = indices[0];
+    while (true)
+    {
+        // A fanning vertex that is no longer cached starts a cluster that does not depend on what was drawn before it
+        if (clusters != nullptr && !inCache(fanningVertex))
+            clusters->push_back(static_cast<uint32_t>(output.size() / 3));
+
+        candidates.clear();
+        for (uint32_t i = offsets[fanningVertex]; i < offsets[fanningVertex + 1]; ++i)
+        {
+            const uint32_t triangle = adjacency[i];
+            if (emitted[triangle])
+                continue;
+
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t vertex = indices[triangle * 3 + corner];
+                output.push_back(vertex);
+                deadEnds.push_back(vertex);
+                candidates.push_back(vertex);
+                --liveTriangles[vertex];
+                if (!inCache(vertex))
+                    cacheTimestamps[vertex] = timestamp++;
+            }
+            emitted[triangle] = true;
+        }
+
+        // Prefer the candidate that will still be cached after its remaining triangles are emitted and is the oldest one
+        int64_t bestPriority = -1;
+        uint32_t nextVertex = UINT32_MAX;
+        for (uint32_t vertex : candidates)
+        {
+            if (liveTriangles[vertex] == 0)
+                continue;
+
+            int64_t priority = 0;
+            if (timestamp - cacheTimestamps[vertex] + 2 * liveTriangles[vertex] <= cacheSize)
+                priority = timestamp - cacheTimestamps[vertex];
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                nextVertex = vertex;
+            }
+        }
+
+        // Dead end, fall back to recently emitted vertices and then to the first vertex with triangles left
+        while (nextVertex == UINT32_MAX && !deadEnds.empty())
+        {
+            if (liveTriangles[deadEnds.back()] > 0)
+                nextVertex = deadEnds.back();
+            deadEnds.pop_back();
+        }
+        while (nextVertex == UINT32_MAX && scanCursor < vertexCount)
+        {
+            if (liveTriangles[scanCursor] > 0)
+                nextVertex = scanCursor;
+            ++scanCursor;
+        }
+
+        if (nextVertex == UINT32_MAX)
+            break;
+        fanningVertex = nextVertex;
+    }
+
+    indices.swap(output);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& clusters)
+{
+    const auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    if (clusters.size() < 2)
+        return;
+
+    struct Cluster
+    {
+        uint32_t firstTriangle;
+        uint32_t triangleCount;
+        float sortKey;
+    };
+
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    std::vector<Cluster> sortedClusters(clusters.size());
+    std::vector<glm::vec3> clusterCentroids(clusters.size());
+    std::vector<glm::vec3> clusterNormals(clusters.size());
+
+    for (size_t cluster = 0; cluster < clusters.size(); ++cluster)
+    {
+        const uint32_t end = cluster + 1 < clusters.size() ? clusters[cluster + 1] : triangleCount;
+        glm::vec3 centroid(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+
+        for (uint32_t triangle = clusters[cluster]; triangle < end; ++triangle)
+        {
+            const glm::vec3& p0 = vertices[indices[triangle * 3 + 0]].position;
+            const glm::vec3& p1 = vertices[indices[triangle * 3 + 1]].position;
+            const glm::vec3& p2 = vertices[indices[triangle * 3 + 2]].position;
+
+            // Twice the area, the factor cancels out
+            const glm::vec3 triangleNormal = glm::cross(p1 - p0, p2 - p0);
+            const float triangleArea = glm::length(triangleNormal);
+            centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+            normal += triangleNormal;
+            area += triangleArea;
+        }
+
+        meshCentroid += centroid;
+        meshArea += area;
+        clusterCentroids[cluster] = area > 0.0f ? centroid / area : centroid;
+        const float normalLength = glm::length(normal);
+        clusterNormals[cluster] = normalLength > 0.0f ? normal / normalLength : normal;
+        sortedClusters[cluster] = {clusters[cluster], end - clusters[cluster], 0.0f};
+    }
+
+    if (meshArea > 0.0f)
+        meshCentroid /= meshArea;
+
+    // Clusters far out along their own normal are likely to occlude the rest of the mesh from most directions, draw them first
+    for (size_t cluster = 0; cluster < clusters.size(); ++cluster)
+        sortedClusters[cluster].sortKey = glm::dot(clusterCentroids[cluster] - meshCentroid, clusterNormals[cluster]);
+
+    std::stable_sort(sortedClusters.begin(), sortedClusters.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (const auto& cluster : sortedClusters)
+    {
+        output.insert(output.end(), indices.begin() + cluster.firstTriangle * 3,
+                      indices.begin() + (cluster.firstTriangle + cluster.triangleCount) * 3);
+    }
+    indices.swap(output);
+}
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+    // Vertices are renumbered in the order the index buffer first uses them, unreferenced ones are dropped
+    std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+    std::vector<Vertex> output;
+    output.reserve(vertices.size());
+
+    for (uint32_t& index : indices)
+    {
+        if (remap[index] == UINT32_MAX)
+        {
+            remap[index] = static_cast<uint32_t>(output.size());
+            output.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    vertices.swap(output);
+}
+
+VertexCacheStatistics MeshOptimizer::analyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize)
+{
+    VertexCacheStatistics statistics;
+    if (indices.empty() || vertexCount == 0)
+        return statistics;
+
+    // Same timestamp trick as Tipsify: a vertex is cached while fewer than cacheSize misses happened since it was loaded
+    std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+    uint32_t timestamp = cacheSize + 1;
+    uint32_t misses = 0;
+    for (uint32_t index : indices)
+    {
+        if (timestamp - cacheTimestamps[index] > cacheSize)
+        {
+            cacheTimestamps[index] = timestamp++;
+            ++misses;
+        }
+    }
+
+    statistics.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    statistics.atvr = static_cast<float>(misses) / static_cast<float>(vertexCount);
+    return statistics;
+}
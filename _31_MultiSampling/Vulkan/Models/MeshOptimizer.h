@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "../Vertex/Vertex.h"
+
+struct VertexCacheStatistics
+{
+    float acmr = 0.0f; // Average cache miss ratio, vertex shader invocations per triangle
+    float atvr = 0.0f; // Average transformed vertex ratio, vertex shader invocations per unique vertex
+};
+
+// Reorders an indexed triangle list after loading: triangles for the post transform vertex cache (Tipsify), clusters of
+// triangles so outer surfaces are drawn first to reduce overdraw, and finally the vertex array into first use order so vertex
+// fetches walk memory linearly. The rendered result does not change.
+class MeshOptimizer
+{
+public:
+    static void optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    // Cluster start offsets in triangles are appended to clusters when it is not null
+    static void optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>* clusters);
+    static void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& clusters);
+    static void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    // Simulates a FIFO cache of the given size
+    static VertexCacheStatistics analyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize);
+
+    // Cache size Tipsify optimizes for and the statistics are reported with, small enough to hold on most GPUs
+    static uint32_t cacheSize;
+};
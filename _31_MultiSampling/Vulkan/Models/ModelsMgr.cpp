@@ -3,14 +3,58 @@
 #include <tiny_obj_loader.h>
 #include "../Vertex/Vertex.h"
 
-#include <unordered_map>
+#include <limits>
 
+#include "MeshOptimizer.h"
+#include "ObjParser.h"
 #include "../Vertex/VertexDataMgr.h"
+#include "../Vertex/VertexHashTable.h"
 
 const std::string MODEL_PATH = "../Models/viking_room.obj";
 const std::string TEXTURE_PATH = "../Textures/viking_room.png";
 
+MeshBounds ModelsMgr::bounds{};
+MappedFile ModelsMgr::meshCacheFile{};
+
 void ModelsMgr::loadModel()
+{
+    const uint64_t sourceHash = MeshCache::hashFile(MODEL_PATH);
+    const std::string cachePath = MeshCache::getCachePath(MODEL_PATH);
+
+    MeshCacheView cachedMesh;
+    if (sourceHash != 0 && MeshCache::load(cachePath, sourceHash, meshCacheFile, cachedMesh))
+    {
+        VertexDataMgr::vertices.clear();
+        VertexDataMgr::indices.clear();
+        VertexDataMgr::meshData = {cachedMesh.vertices, cachedMesh.vertexCount, cachedMesh.indices, cachedMesh.indexCount};
+        bounds = cachedMesh.bounds;
+        return;
+    }
+
+    // tinyobj is kept for files the parallel parser does not understand
+    if (!ObjParser::parse(MODEL_PATH, VertexDataMgr::vertices, VertexDataMgr::indices, bounds))
+        parseModel();
+    // Optimized arrays go into the cache, so this only runs when the model is parsed
+    MeshOptimizer::optimize(VertexDataMgr::vertices, VertexDataMgr::indices);
+    VertexDataMgr::meshData = {VertexDataMgr::vertices.data(), static_cast<uint32_t>(VertexDataMgr::vertices.size()),
+                               VertexDataMgr::indices.data(), static_cast<uint32_t>(VertexDataMgr::indices.size())};
+
+    if (sourceHash != 0)
+    {
+        MeshCache::write(cachePath, sourceHash, VertexDataMgr::meshData.vertices, VertexDataMgr::meshData.vertexCount,
+                         VertexDataMgr::meshData.indices, VertexDataMgr::meshData.indexCount, bounds);
+    }
+}
+
+void ModelsMgr::releaseModel()
+{
+    // The draw call only needs the index count, which meshData keeps
+    VertexDataMgr::meshData.vertices = nullptr;
+    VertexDataMgr::meshData.indices = nullptr;
+    meshCacheFile.close();
+}
+
+void ModelsMgr::parseModel()
 {
     VertexDataMgr::vertices.clear();
     VertexDataMgr::indices.clear();
@@ -25,7 +69,14 @@ void ModelsMgr::loadModel()
         throw std::runtime_error(warn + err);
     }
 
-    std::unordered_map<Vertex, uint32_t> uniqueVertices{};
+    size_t indexCount = 0;
+    for (const auto& shape : shapes)
+        indexCount += shape.mesh.indices.size();
+    VertexDataMgr::indices.reserve(indexCount);
+
+    VertexHashTable uniqueVertices(VertexDataMgr::vertices, indexCount);
+    bounds.min = glm::vec3(std::numeric_limits<float>::max());
+    bounds.max = glm::vec3(std::numeric_limits<float>::lowest());
 
     for (const auto& shape : shapes)
     {
@@ -46,13 +97,10 @@ void ModelsMgr::loadModel()
 
             vertex.color = {1.0f, 1.0f, 1.0f};
 
-            if (uniqueVertices.count(vertex) == 0)
-            {
-                uniqueVertices[vertex] = static_cast<uint32_t>(VertexDataMgr::vertices.size());
-                VertexDataMgr::vertices.push_back(vertex);
-            }
+            bounds.min = glm::min(bounds.min, vertex.position);
+            bounds.max = glm::max(bounds.max, vertex.position);
 
-            VertexDataMgr::indices.push_back(uniqueVertices[vertex]);
+            VertexDataMgr::indices.push_back(uniqueVertices.insertOrFind(vertex));
         }
     }
 }
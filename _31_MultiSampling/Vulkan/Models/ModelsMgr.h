@@ -1,8 +1,19 @@
 #pragma once
 
+#include "MeshCache.h"
+
 class ModelsMgr
 {
 public:
+    // Uses the binary mesh cache when it matches the OBJ, otherwise parses the OBJ and writes the cache for the next run
     static void loadModel();
-};
+    // Unmaps the mesh cache, call it once the vertex and index data has been copied into the staging buffer
+    static void releaseModel();
+
+    static MeshBounds bounds;
 
+private:
+    static void parseModel();
+
+    static MappedFile meshCacheFile;
+};
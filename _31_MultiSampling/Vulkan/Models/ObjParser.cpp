@@ -0,0 +1,425 @@
+#include "ObjParser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+#include "../Utils/MappedFile.h"
+#include "../Utils/ThreadPool.h"
+#include "../Vertex/VertexHashTable.h"
+
+namespace
+{
+constexpr uint32_t NO_TEXCOORD = UINT32_MAX;
+constexpr size_t MIN_CHUNK_SIZE = 1 << 20;
+constexpr size_t CORNER_GRAIN = 1 << 16;
+
+struct Corner
+{
+    uint32_t position;
+    uint32_t texcoord;
+};
+
+struct Chunk
+{
+    const char* begin;
+    const char* end;
+    uint32_t positionCount = 0;
+    uint32_t texcoordCount = 0;
+    uint32_t positionBase = 0;
+    uint32_t texcoordBase = 0;
+    std::vector<Corner> corners; // Already triangulated
+    std::vector<size_t> quads;   // Offsets into corners of quads, emitted as [0, 1, 2], [0, 2, 3] until fixQuads picks the diagonal
+    bool failed = false;
+};
+
+enum class LineType
+{
+    Other,
+    Position,
+    Texcoord,
+    Face
+};
+
+bool isSpace(char character)
+{
+    return character == ' ' || character == '\t';
+}
+
+const char* skipSpaces(const char* cursor, const char* end)
+{
+    while (cursor < end && isSpace(*cursor))
+        ++cursor;
+    return cursor;
+}
+
+LineType getLineType(const char* cursor, const char* end)
+{
+    const ptrdiff_t length = end - cursor;
+    if (length >= 2 && cursor[0] == 'v' && isSpace(cursor[1]))
+        return LineType::Position;
+    if (length >= 3 && cursor[0] == 'v' && cursor[1] == 't' && isSpace(cursor[2]))
+        return LineType::Texcoord;
+    if (length >= 2 && cursor[0] == 'f' && isSpace(cursor[1]))
+        return LineType::Face;
+    return LineType::Other;
+}
+
+// Calls function(lineBegin, lineEnd) for every line in [begin, end), leading blanks and the trailing '\r' stripped
+template <typename Function>
+bool forEachLine(const char* begin, const char* end, Function&& function)
+{
+    for (const char* cursor = begin; cursor < end;)
+    {
+        const auto* newline = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+        const char* lineEnd = newline != nullptr ? newline : end;
+        const char* lineBegin = skipSpaces(cursor, lineEnd);
+        const char* contentEnd = lineEnd > lineBegin && lineEnd[-1] == '\r' ? lineEnd - 1 : lineEnd;
+        if (!function(lineBegin, contentEnd))
+            return false;
+        cursor = lineEnd + 1;
+    }
+    return true;
+}
+
+bool parseFloat(const char*& cursor, const char* end, float& value)
+{
+    cursor = skipSpaces(cursor, end);
+    // from_chars does not accept a leading plus sign
+    if (cursor < end && *cursor == '+')
+        ++cursor;
+
+    const auto result = std::from_chars(cursor, end, value);
+    if (result.ec != std::errc())
+        return false;
+    cursor = result.ptr;
+    return true;
+}
+
+bool parseInteger(const char*& cursor, const char* end, int64_t& value)
+{
+    if (cursor < end && *cursor == '+')
+        ++cursor;
+
+    const auto result = std::from_chars(cursor, end, value);
+    if (result.ec != std::errc())
+        return false;
+    cursor = result.ptr;
+    return true;
+}
+
+// OBJ indices are 1 based, negative ones count back from the last element defined before the face
+bool resolveIndex(int64_t index, uint32_t definedSoFar, uint32_t total, uint32_t& resolved)
+{
+    if (index > 0 && index <= total)
+        resolved = static_cast<uint32_t>(index - 1);
+    else if (index < 0 && -index <= definedSoFar)
+        resolved = static_cast<uint32_t>(definedSoFar + index);
+    else
+        return false;
+    return true;
+}
+
+bool parseChunk(Chunk& chunk, std::vector<glm::vec3>& positions, std::vector<glm::vec2>& texcoords)
+{
+    const auto totalPositions = static_cast<uint32_t>(positions.size());
+    const auto totalTexcoords = static_cast<uint32_t>(texcoords.size());
+    uint32_t positionIndex = chunk.positionBase;
+    uint32_t texcoordIndex = chunk.texcoordBase;
+    std::vector<Corner> polygon;
+
+    return forEachLine(chunk.begin, chunk.end, [&](const char* cursor, const char* lineEnd)
+    {
+        // Line continuations would join lines across chunk boundaries
+        if (lineEnd > cursor && lineEnd[-1] == '\\')
+            return false;
+
+        switch (getLineType(cursor, lineEnd))
+        {
+        case LineType::Position:
+        {
+            glm::vec3& position = positions[positionIndex++];
+            cursor += 1;
+            return parseFloat(cursor, lineEnd, position.x) && parseFloat(cursor, lineEnd, position.y) &&
+                parseFloat(cursor, lineEnd, position.z);
+        }
+        case LineType::Texcoord:
+        {
+            glm::vec2& texcoord = texcoords[texcoordIndex++];
+            cursor += 2;
+            if (!parseFloat(cursor, lineEnd, texcoord.x))
+                return false;
+            texcoord.y = 0.0f;
+            return skipSpaces(cursor, lineEnd) == lineEnd || parseFloat(cursor, lineEnd, texcoord.y);
+        }
+        case LineType::Face:
+        {
+            polygon.clear();
+            cursor = skipSpaces(cursor + 1, lineEnd);
+            while (cursor < lineEnd)
+            {
+                Corner corner{0, NO_TEXCOORD};
+                int64_t index = 0;
+                if (!parseInteger(cursor, lineEnd, index) || !resolveIndex(index, positionIndex, totalPositions, corner.position))
+                    return false;
+
+                if (cursor < lineEnd && *cursor == '/')
+                {
+                    ++cursor;
+                    if (cursor < lineEnd && *cursor != '/')
+                    {
+                        if (!parseInteger(cursor, lineEnd, index) || !resolveIndex(index, texcoordIndex, totalTexcoords, corner.texcoord))
+                            return false;
+                    }
+                    // Normals are not used by the renderer
+                    if (cursor < lineEnd && *cursor == '/')
+                    {
+                        ++cursor;
+                        if (!parseInteger(cursor, lineEnd, index))
+                            return false;
+                    }
+                }
+
+                if (cursor < lineEnd && !isSpace(*cursor))
+                    return false;
+                polygon.push_back(corner);
+                cursor = skipSpaces(cursor, lineEnd);
+            }
+
+            // tinyobj ear clips larger polygons, leave those files to it
+            if (polygon.size() < 3 || polygon.size() > 4)
+                return false;
+
+            if (polygon.size() == 4)
+                chunk.quads.push_back(chunk.corners.size());
+            chunk.corners.insert(chunk.corners.end(), {polygon[0], polygon[1], polygon[2]});
+            if (polygon.size() == 4)
+                chunk.corners.insert(chunk.corners.end(), {polygon[0], polygon[2], polygon[3]});
+            return true;
+        }
+        default:
+            return true;
+        }
+    });
+}
+
+// Splits every quad along its shorter diagonal like tinyobj does. Runs after parsing, a face may use positions of later chunks
+void fixQuads(Chunk& chunk, const std::vector<glm::vec3>& positions)
+{
+    for (const size_t offset : chunk.quads)
+    {
+        Corner* const triangles = &chunk.corners[offset];
+        const Corner quad[4] = {triangles[0], triangles[1], triangles[2], triangles[5]};
+        // Same float expression as tinyobj, so ties split the same way
+        const glm::vec3 e02 = positions[quad[2].position] - positions[quad[0].position];
+        const glm::vec3 e13 = positions[quad[3].position] - positions[quad[1].position];
+        const float sqr02 = e02.x * e02.x + e02.y * e02.y + e02.z * e02.z;
+        const float sqr13 = e13.x * e13.x + e13.y * e13.y + e13.z * e13.z;
+        if (sqr02 < sqr13)
+            continue;
+
+        // [0, 1, 3], [1, 2, 3]
+        triangles[2] = quad[3];
+        triangles[3] = quad[1];
+        triangles[4] = quad[2];
+        triangles[5] = quad[3];
+    }
+}
+
+Vertex makeVertex(const Corner& corner, const std::vector<glm::vec3>& positions, const std::vector<glm::vec2>& texcoords)
+{
+    Vertex vertex{};
+    vertex.position = positions[corner.position];
+    if (corner.texcoord != NO_TEXCOORD)
+        vertex.texCoord = {texcoords[corner.texcoord].x, 1.0f - texcoords[corner.texcoord].y};
+    vertex.color = {1.0f, 1.0f, 1.0f};
+    return vertex;
+}
+}
+
+bool ObjParser::parse(const std::string& path, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, MeshBounds& bounds)
+{
+    MappedFile file;
+    if (!file.open(path))
+        return false;
+
+    ThreadPool& pool = ThreadPool::getShared();
+    const char* const fileBegin = static_cast<const char*>(file.data());
+    const char* const fileEnd = fileBegin + file.size();
+
+    // Split into line aligned chunks, a few per thread so uneven chunks still balance
+    const size_t targetChunkSize = std::max(MIN_CHUNK_SIZE, file.size() / (pool.getThreadCount() * 4));
+    std::vector<Chunk> chunks;
+    for (const char* begin = fileBegin; begin < fileEnd;)
+    {
+        const char* end = begin + std::min(targetChunkSize, static_cast<size_t>(fileEnd - begin));
+        const auto* newline = end < fileEnd ? static_cast<const char*>(std::memchr(end, '\n', static_cast<size_t>(fileEnd - end))) : nullptr;
+        end = newline != nullptr ? newline + 1 : fileEnd;
+
+        Chunk chunk;
+        chunk.begin = begin;
+        chunk.end = end;
+        chunks.push_back(std::move(chunk));
+        begin = end;
+    }
+
+    // First pass only counts elements, so every chunk knows where its positions and texcoords land in the global arrays and
+    // relative indices can be resolved while parsing
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            Chunk& chunk = chunks[i];
+            forEachLine(chunk.begin, chunk.end, [&chunk](const char* cursor, const char* lineEnd)
+            {
+                const LineType type = getLineType(cursor, lineEnd);
+                chunk.positionCount += type == LineType::Position ? 1 : 0;
+                chunk.texcoordCount += type == LineType::Texcoord ? 1 : 0;
+                return true;
+            });
+        }
+    });
+
+    uint64_t positionCount = 0;
+    uint64_t texcoordCount = 0;
+    for (Chunk& chunk : chunks)
+    {
+        chunk.positionBase = static_cast<uint32_t>(positionCount);
+        chunk.texcoordBase = static_cast<uint32_t>(texcoordCount);
+        positionCount += chunk.positionCount;
+        texcoordCount += chunk.texcoordCount;
+    }
+    if (positionCount >= UINT32_MAX || texcoordCount >= UINT32_MAX)
+        return false;
+
+    std::vector<glm::vec3> positions(positionCount);
+    std::vector<glm::vec2> texcoords(texcoordCount);
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+            chunks[i].failed = !parseChunk(chunks[i], positions, texcoords);
+    });
+
+    // Concatenating the chunks in file order keeps the result independent of scheduling
+    std::vector<size_t> cornerOffsets(chunks.size() + 1, 0);
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        if (chunks[i].failed)
+            return false;
+        cornerOffsets[i + 1] = cornerOffsets[i] + chunks[i].corners.size();
+    }
+
+    const size_t cornerCount = cornerOffsets.back();
+    if (cornerCount == 0 || cornerCount >= UINT32_MAX)
+        return false;
+
+    std::vector<Corner> corners(cornerCount);
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            fixQuads(chunks[i], positions);
+            std::copy(chunks[i].corners.begin(), chunks[i].corners.end(), corners.begin() + static_cast<ptrdiff_t>(cornerOffsets[i]));
+            std::vector<Corner>().swap(chunks[i].corners);
+        }
+    });
+    file.close();
+
+    // Dedup: corners are sharded by hash so every shard can run its own table, equal vertices always land in the same shard
+    size_t shardCount = 16;
+    while (shardCount < pool.getThreadCount() * 4 && shardCount < 256)
+        shardCount <<= 1;
+    // Middle bits, the low ones pick the slot inside a shard's table and the high ones are its tag
+    const auto getShard = [shardCount](uint64_t hash) { return static_cast<size_t>(hash >> 24) & (shardCount - 1); };
+
+    const size_t grainCount = (cornerCount + CORNER_GRAIN - 1) / CORNER_GRAIN;
+    std::vector<uint64_t> hashes(cornerCount);
+    std::vector<std::vector<uint32_t>> shardCorners(grainCount * shardCount);
+    bounds.min = glm::vec3(std::numeric_limits<float>::max());
+    bounds.max = glm::vec3(std::numeric_limits<float>::lowest());
+    std::mutex boundsMutex;
+
+    pool.parallelFor(cornerCount, CORNER_GRAIN, [&](size_t begin, size_t end)
+    {
+        MeshBounds grainBounds{glm::vec3(std::numeric_limits<float>::max()), glm::vec3(std::numeric_limits<float>::lowest())};
+        const size_t grain = begin / CORNER_GRAIN;
+        for (size_t corner = begin; corner < end; ++corner)
+        {
+            const Vertex vertex = makeVertex(corners[corner], positions, texcoords);
+            hashes[corner] = VertexHashTable::hash(vertex);
+            shardCorners[grain * shardCount + getShard(hashes[corner])].push_back(static_cast<uint32_t>(corner));
+            grainBounds.min = glm::min(grainBounds.min, vertex.position);
+            grainBounds.max = glm::max(grainBounds.max, vertex.position);
+        }
+
+        std::lock_guard<std::mutex> lock(boundsMutex);
+        bounds.min = glm::min(bounds.min, grainBounds.min);
+        bounds.max = glm::max(bounds.max, grainBounds.max);
+    });
+
+    // Each shard walks its corners in file order, so the first corner of every unique vertex is known afterwards
+    std::vector<std::vector<Vertex>> shardVertices(shardCount);
+    std::vector<std::vector<uint32_t>> shardFirstCorners(shardCount);
+    std::vector<uint32_t> cornerLocalIndices(cornerCount);
+    std::vector<uint8_t> isFirstCorner(cornerCount, 0);
+
+    pool.parallelFor(shardCount, 1, [&](size_t begin, size_t end)
+    {
+        for (size_t shard = begin; shard < end; ++shard)
+        {
+            size_t shardCornerCount = 0;
+            for (size_t grain = 0; grain < grainCount; ++grain)
+                shardCornerCount += shardCorners[grain * shardCount + shard].size();
+
+            VertexHashTable table(shardVertices[shard], shardCornerCount);
+            for (size_t grain = 0; grain < grainCount; ++grain)
+            {
+                for (uint32_t corner : shardCorners[grain * shardCount + shard])
+                {
+                    const size_t uniqueCount = shardVertices[shard].size();
+                    cornerLocalIndices[corner] = table.insertOrFind(makeVertex(corners[corner], positions, texcoords), hashes[corner]);
+                    if (shardVertices[shard].size() != uniqueCount)
+                    {
+                        shardFirstCorners[shard].push_back(corner);
+                        isFirstCorner[corner] = 1;
+                    }
+                }
+            }
+        }
+    });
+
+    // Numbering unique vertices by their first corner gives the same order as a sequential dedup
+    indices.resize(cornerCount);
+    uint32_t uniqueCount = 0;
+    for (size_t corner = 0; corner < cornerCount; ++corner)
+    {
+        if (isFirstCorner[corner])
+            indices[corner] = uniqueCount++;
+    }
+
+    vertices.resize(uniqueCount);
+    std::vector<std::vector<uint32_t>> localToGlobal(shardCount);
+    pool.parallelFor(shardCount, 1, [&](size_t begin, size_t end)
+    {
+        for (size_t shard = begin; shard < end; ++shard)
+        {
+            localToGlobal[shard].resize(shardFirstCorners[shard].size());
+            for (size_t local = 0; local < shardFirstCorners[shard].size(); ++local)
+            {
+                const uint32_t global = indices[shardFirstCorners[shard][local]];
+                localToGlobal[shard][local] = global;
+                vertices[global] = shardVertices[shard][local];
+            }
+        }
+    });
+
+    pool.parallelFor(cornerCount, CORNER_GRAIN, [&](size_t begin, size_t end)
+    {
+        for (size_t corner = begin; corner < end; ++corner)
+            indices[corner] = localToGlobal[getShard(hashes[corner])][cornerLocalIndices[corner]];
+    });
+
+    return true;
+}
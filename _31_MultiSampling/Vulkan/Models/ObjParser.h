@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MeshCache.h"
+#include "../Vertex/Vertex.h"
+
+// Parallel reader for the part of the OBJ format the renderer uses: positions, texture coordinates and triangle or quad faces.
+// Quads are split along the shorter diagonal as tinyobj does, files with larger polygons are left to tinyobj's ear clipping.
+// The file is memory mapped and split into line aligned chunks that are parsed on the shared thread pool, then the corners
+// are deduplicated in hash sharded parallel passes. The output is identical to a sequential first occurrence dedup.
+class ObjParser
+{
+public:
+    // Returns false when the file cannot be read or contains syntax this parser does not handle, callers then fall back to tinyobj
+    static bool parse(const std::string& path, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, MeshBounds& bounds);
+};
@@ -1,6 +1,7 @@
 ﻿#include "MsaaMgr.h"
 
 #include "LogicalDevicesMgr.h"
+#include "Memory/MemoryAllocatorMgr.h"
 #include "PhysicalDevicesMgr.h"
 #include "SwapChain/SwapChainMgr.h"
 #include "Textures/TextureMgr.h"
@@ -8,7 +9,7 @@
 
 VkImage MsaaMgr::colorImage = VK_NULL_HANDLE;
 VkImageView MsaaMgr::colorImageView = VK_NULL_HANDLE;
-VkDeviceMemory MsaaMgr::colorImageMemory = VK_NULL_HANDLE;
+MemoryAllocation MsaaMgr::colorImageMemory{};
 
 void MsaaMgr::createColorResources()
 {
@@ -24,5 +25,5 @@ void MsaaMgr::destroyColorResources()
 {
     vkDestroyImageView(LogicalDevicesMgr::device, colorImageView, nullptr);
     vkDestroyImage(LogicalDevicesMgr::device, colorImage, nullptr);
-    vkFreeMemory(LogicalDevicesMgr::device, colorImageMemory, nullptr);
+    MemoryAllocatorMgr::freeMemory(colorImageMemory);
 }
\ No newline at end of file
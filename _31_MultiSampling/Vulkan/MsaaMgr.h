@@ -1,12 +1,13 @@
 ﻿#pragma once
 #include "Utils/ImageHelper.h"
+#include "Memory/MemoryAllocation.h"
 
 class MsaaMgr
 {
 public:
     static VkImage colorImage;
     static VkImageView colorImageView;
-    static VkDeviceMemory colorImageMemory;
+    static MemoryAllocation colorImageMemory;
 
     static void createColorResources();
     static void destroyColorResources();
@@ -1,9 +1,12 @@
 #include "PhysicalDevicesMgr.h"
 
+#include <algorithm>
 #include <set>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
+#include "SurfaceMgr.h"
 #include "QueueFamily/QueueFamilyIndices.h"
 #include "QueueFamily/QueueFamilyMgr.h"
 #include "SwapChain/SwapChainMgr.h"
@@ -24,6 +27,22 @@ void PhysicalDevicesMgr::pickPhysicalDevice(VkInstance instance)
     std::vector<VkPhysicalDevice> devices(deviceCount);
     vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
 
+    if (!SurfaceMgr::hasSurface())
+    {
+        deviceExtensions.erase(std::remove_if(deviceExtensions.begin(), deviceExtensions.end(), [](const char* extension)
+        {
+            return std::string(extension) == VK_KHR_SWAPCHAIN_EXTENSION_NAME;
+        }), deviceExtensions.end());
+
+        // Headless machines usually only expose integrated or software devices (e.g. lavapipe), still prefer a discrete one
+        std::stable_partition(devices.begin(), devices.end(), [](VkPhysicalDevice device)
+        {
+            VkPhysicalDeviceProperties deviceProperties;
+            vkGetPhysicalDeviceProperties(device, &deviceProperties);
+            return deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
+        });
+    }
+
     for (const auto& device : devices)
     {
         if (isDeviceSuitable(device))
@@ -63,13 +82,13 @@ bool PhysicalDevicesMgr::isDeviceSuitable(VkPhysicalDevice device)
     vkGetPhysicalDeviceFeatures(device, &deviceFeatures);
 
     QueueFamilyIndices indices = QueueFamilyMgr::findQueueFamilies(device);
-    const bool deviceSuitable = deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU &&
+    const bool deviceSuitable = (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU || !SurfaceMgr::hasSurface()) &&
                                 deviceFeatures.geometryShader;
     const bool queueFamilySuitable = indices.isComplete();
 
     bool extensionSupport = checkDeviceExtensionsSupport(device);
-    bool swapChainAdequate = false;
-    if (extensionSupport)
+    bool swapChainAdequate = !SurfaceMgr::hasSurface();
+    if (extensionSupport && SurfaceMgr::hasSurface())
     {
         SwapChainSupportDetails swapChainSupport = SwapChainMgr::querySwapChainSupport(device);
         swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
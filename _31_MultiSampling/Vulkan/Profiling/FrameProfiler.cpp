@@ -0,0 +1,183 @@
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+uint32_t FrameProfiler::frameCapacity = 4096;
+uint32_t FrameProfiler::reportInterval = 1000;
+std::vector<FrameRecord> FrameProfiler::frames{};
+std::atomic<uint64_t> FrameProfiler::publishedFrames{0};
+std::chrono::steady_clock::time_point FrameProfiler::frameStart{};
+
+namespace
+{
+constexpr size_t STAGE_COUNT = static_cast<size_t>(FrameStage::Count);
+}
+
+void FrameProfiler::createProfiler()
+{
+    frames.assign(std::max<uint32_t>(frameCapacity, 2), FrameRecord{});
+    publishedFrames.store(0, std::memory_order_relaxed);
+}
+
+void FrameProfiler::beginFrame()
+{
+    if (frames.empty())
+        return;
+
+    const uint64_t frameIndex = publishedFrames.load(std::memory_order_relaxed);
+    FrameRecord& frame = frames[frameIndex % frames.size()];
+    frame.frameIndex = frameIndex;
+    frame.stageMs.fill(0.0f);
+    frameStart = std::chrono::steady_clock::now();
+}
+
+void FrameProfiler::endFrame()
+{
+    if (frames.empty())
+        return;
+
+    record(FrameStage::Frame, std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+
+    const uint64_t frameCount = publishedFrames.load(std::memory_order_relaxed) + 1;
+    publishedFrames.store(frameCount, std::memory_order_release);
+
+    if (reportInterval != 0 && frameCount % reportInterval == 0)
+        printReport();
+}
+
+void FrameProfiler::record(FrameStage stage, float milliseconds)
+{
+    if (frames.empty())
+        return;
+
+    // Stages accumulate, so a stage entered twice in one frame reports its total
+    FrameRecord& frame = frames[publishedFrames.load(std::memory_order_relaxed) % frames.size()];
+    frame.stageMs[static_cast<size_t>(stage)] += milliseconds;
+}
+
+std::vector<FrameRecord> FrameProfiler::collectRecords()
+{
+    if (frames.empty())
+        return {};
+
+    // The slot after the newest published frame is being written by the current frame, so one slot is never readable
+    const uint64_t published = publishedFrames.load(std::memory_order_acquire);
+    const uint64_t count = std::min<uint64_t>(published, frames.size() - 1);
+
+    std::vector<FrameRecord> records;
+    records.reserve(static_cast<size_t>(count));
+    for (uint64_t frameIndex = published - count; frameIndex < published; ++frameIndex)
+        records.push_back(frames[frameIndex % frames.size()]);
+    return records;
+}
+
+float FrameProfiler::percentile(std::vector<float>& values, float fraction)
+{
+    if (values.empty())
+        return 0.0f;
+
+    const size_t index = static_cast<size_t>(fraction * static_cast<float>(values.size() - 1) + 0.5f);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void FrameProfiler::printReport()
+{
+    const std::vector<FrameRecord> records = collectRecords();
+    if (records.empty())
+        return;
+
+    std::array<float, STAGE_COUNT> medians{};
+    std::cout << "frame timings over the last " << records.size() << " frames (ms, p50 / p95 / p99):\n";
+    for (size_t stage = 0; stage < STAGE_COUNT; ++stage)
+    {
+        std::vector<float> values(records.size());
+        for (size_t i = 0; i < records.size(); ++i)
+            values[i] = records[i].stageMs[stage];
+
+        medians[stage] = percentile(values, 0.50f);
+        const float p95 = percentile(values, 0.95f);
+        const float p99 = percentile(values, 0.99f);
+        std::cout << '\t' << std::left << std::setw(16) << getStageName(static_cast<FrameStage>(stage)) << std::right << std::fixed
+            << std::setprecision(3) << medians[stage] << " / " << p95 << " / " << p99 << '\n';
+    }
+    std::cout << std::defaultfloat;
+
+    // Waiting on the frame fence means the GPU is behind, blocking in acquire or present means the presentation engine is
+    const float gpu = medians[static_cast<size_t>(FrameStage::FenceWait)];
+    const float present = medians[static_cast<size_t>(FrameStage::Acquire)] + medians[static_cast<size_t>(FrameStage::Present)];
+    const float cpu = medians[static_cast<size_t>(FrameStage::UpdateUniforms)] + medians[static_cast<size_t>(FrameStage::Record)] +
+        medians[static_cast<size_t>(FrameStage::Submit)];
+    const char* bound = gpu >= present && gpu >= cpu ? "GPU" : present >= cpu ? "present" : "CPU";
+    std::cout << "\tlikely " << bound << " bound\n";
+}
+
+void FrameProfiler::writeCsv(const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file)
+        throw std::runtime_error("failed to open " + path);
+
+    file << "frame";
+    for (size_t stage = 0; stage < STAGE_COUNT; ++stage)
+        file << ',' << getStageName(static_cast<FrameStage>(stage)) << "_ms";
+    file << '\n';
+
+    for (const FrameRecord& record : collectRecords())
+    {
+        file << record.frameIndex;
+        for (float milliseconds : record.stageMs)
+            file << ',' << milliseconds;
+        file << '\n';
+    }
+}
+
+void FrameProfiler::writeJson(const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file)
+        throw std::runtime_error("failed to open " + path);
+
+    const std::vector<FrameRecord> records = collectRecords();
+
+    file << "{\n  \"summary\": {";
+    for (size_t stage = 0; stage < STAGE_COUNT; ++stage)
+    {
+        std::vector<float> values(records.size());
+        for (size_t i = 0; i < records.size(); ++i)
+            values[i] = records[i].stageMs[stage];
+
+        file << (stage == 0 ? "\n" : ",\n") << "    \"" << getStageName(static_cast<FrameStage>(stage)) << "\": {\"p50\": "
+            << percentile(values, 0.50f) << ", \"p95\": " << percentile(values, 0.95f) << ", \"p99\": " << percentile(values, 0.99f) << '}';
+    }
+    file << "\n  },\n  \"frames\": [";
+
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        file << (i == 0 ? "\n" : ",\n") << "    {\"frame\": " << records[i].frameIndex;
+        for (size_t stage = 0; stage < STAGE_COUNT; ++stage)
+            file << ", \"" << getStageName(static_cast<FrameStage>(stage)) << "_ms\": " << records[i].stageMs[stage];
+        file << '}';
+    }
+    file << "\n  ]\n}\n";
+}
+
+const char* FrameProfiler::getStageName(FrameStage stage)
+{
+    switch (stage)
+    {
+    case FrameStage::FenceWait: return "fence_wait";
+    case FrameStage::Acquire: return "acquire";
+    case FrameStage::UpdateUniforms: return "update_uniforms";
+    case FrameStage::Record: return "record";
+    case FrameStage::Submit: return "submit";
+    case FrameStage::Present: return "present";
+    case FrameStage::GpuRenderPass: return "gpu_render_pass";
+    case FrameStage::Frame: return "frame";
+    default: return "unknown";
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class FrameStage : uint32_t
+{
+    FenceWait,
+    Acquire,
+    UpdateUniforms,
+    Record,
+    Submit,
+    Present,
+    GpuRenderPass, // Filled in by GpuProfiler
+    Frame,
+    Count
+};
+
+struct FrameRecord
+{
+    uint64_t frameIndex = 0;
+    std::array<float, static_cast<size_t>(FrameStage::Count)> stageMs{};
+};
+
+// Keeps the CPU time of every drawFrame stage for the last frameCapacity frames. The render thread is the only writer, a frame
+// becomes visible to readers once endFrame publishes it, so reports never see a half written record.
+class FrameProfiler
+{
+public:
+    static void createProfiler();
+
+    static void beginFrame();
+    static void endFrame();
+    static void record(FrameStage stage, float milliseconds);
+
+    static void printReport();
+    static void writeCsv(const std::string& path);
+    static void writeJson(const std::string& path);
+
+    static const char* getStageName(FrameStage stage);
+
+    static uint32_t frameCapacity;
+    static uint32_t reportInterval; // Frames between two rolling reports, 0 disables them
+
+private:
+    static std::vector<FrameRecord> collectRecords();
+    static float percentile(std::vector<float>& values, float fraction);
+
+    static std::vector<FrameRecord> frames;
+    static std::atomic<uint64_t> publishedFrames;
+    static std::chrono::steady_clock::time_point frameStart;
+};
+
+class ScopedCpuTimer
+{
+public:
+    explicit ScopedCpuTimer(FrameStage stage) : stage(stage), start(std::chrono::steady_clock::now()) {}
+    ~ScopedCpuTimer()
+    {
+        FrameProfiler::record(stage, std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    ScopedCpuTimer(const ScopedCpuTimer&) = delete;
+    ScopedCpuTimer& operator=(const ScopedCpuTimer&) = delete;
+
+private:
+    FrameStage stage;
+    std::chrono::steady_clock::time_point start;
+};
@@ -0,0 +1,183 @@
+#include "GpuProfiler.h"
+
+#include <iostream>
+#include <stdexcept>
+
+#include "FrameProfiler.h"
+#include "../LogicalDevicesMgr.h"
+#include "../PhysicalDevicesMgr.h"
+#include "../CommandBuffers/CommandBuffersMgr.h"
+#include "../GraphicPipeline/GraphicsPipelineMgr.h"
+
+uint32_t GpuProfiler::uploadScopeCapacity = 32;
+bool GpuProfiler::supported = false;
+float GpuProfiler::timestampPeriod = 1.0f;
+uint64_t GpuProfiler::timestampMask = ~0ull;
+std::vector<VkQueryPool> GpuProfiler::framePools{};
+std::vector<bool> GpuProfiler::frameScopesWritten{};
+VkQueryPool GpuProfiler::uploadPool = VK_NULL_HANDLE;
+std::vector<GpuProfiler::UploadScope> GpuProfiler::uploadScopes{};
+std::vector<GpuTiming> GpuProfiler::uploadTimings{};
+
+namespace
+{
+VkQueryPool createTimestampPool(uint32_t queryCount)
+{
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = queryCount;
+
+    VkQueryPool pool;
+    if (vkCreateQueryPool(LogicalDevicesMgr::device, &poolInfo, nullptr, &pool) != VK_SUCCESS)
+        throw std::runtime_error("failed to create timestamp query pool!");
+    return pool;
+}
+}
+
+void GpuProfiler::createProfiler()
+{
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(PhysicalDevicesMgr::physicalDevice, &deviceProperties);
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(PhysicalDevicesMgr::physicalDevice, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(PhysicalDevicesMgr::physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+    // All timestamps are written on the graphics queue, mip generation included
+    const uint32_t validBits = queueFamilies[LogicalDevicesMgr::graphicsQueueFamily].timestampValidBits;
+    supported = validBits != 0 && deviceProperties.limits.timestampPeriod > 0.0f;
+    if (!supported)
+        return;
+
+    timestampPeriod = deviceProperties.limits.timestampPeriod;
+    timestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+    createFrameScopes();
+
+    // Upload queries are never reused, resetting them all up front lets unsubmitted scopes read back as not ready
+    uploadPool = createTimestampPool(uploadScopeCapacity * 2);
+    const VkCommandBuffer commandBuffer = CommandBuffersMgr::beginSingleTimeCommands();
+    vkCmdResetQueryPool(commandBuffer, uploadPool, 0, uploadScopeCapacity * 2);
+    CommandBuffersMgr::endSingleTimeCommands(commandBuffer);
+}
+
+void GpuProfiler::destroyProfiler()
+{
+    destroyFrameScopes();
+
+    if (uploadPool != VK_NULL_HANDLE)
+        vkDestroyQueryPool(LogicalDevicesMgr::device, uploadPool, nullptr);
+    uploadPool = VK_NULL_HANDLE;
+    uploadScopes.clear();
+}
+
+void GpuProfiler::createFrameScopes()
+{
+    if (!supported)
+        return;
+
+    framePools.resize(GraphicsPipelineMgr::framesInFlight);
+    frameScopesWritten.assign(GraphicsPipelineMgr::framesInFlight, false);
+    for (auto& pool : framePools)
+        pool = createTimestampPool(2);
+}
+
+void GpuProfiler::destroyFrameScopes()
+{
+    for (auto pool : framePools)
+        vkDestroyQueryPool(LogicalDevicesMgr::device, pool, nullptr);
+    framePools.clear();
+    frameScopesWritten.clear();
+}
+
+void GpuProfiler::beginFrameScope(VkCommandBuffer commandBuffer, uint32_t frameIndex)
+{
+    if (!supported)
+        return;
+
+    vkCmdResetQueryPool(commandBuffer, framePools[frameIndex], 0, 2);
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, framePools[frameIndex], 0);
+}
+
+void GpuProfiler::endFrameScope(VkCommandBuffer commandBuffer, uint32_t frameIndex)
+{
+    if (!supported)
+        return;
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, framePools[frameIndex], 1);
+    frameScopesWritten[frameIndex] = true;
+}
+
+void GpuProfiler::collectFrame(uint32_t frameIndex)
+{
+    if (!supported || !frameScopesWritten[frameIndex])
+        return;
+
+    float milliseconds = 0.0f;
+    if (readDuration(framePools[frameIndex], 0, milliseconds))
+        FrameProfiler::record(FrameStage::GpuRenderPass, milliseconds);
+    frameScopesWritten[frameIndex] = false;
+}
+
+uint32_t GpuProfiler::beginUploadScope(VkCommandBuffer commandBuffer, const char* name)
+{
+    if (!supported || uploadScopes.size() >= uploadScopeCapacity)
+        return UINT32_MAX;
+
+    const auto scope = static_cast<uint32_t>(uploadScopes.size());
+    uploadScopes.push_back({name, false});
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, uploadPool, scope * 2);
+    return scope;
+}
+
+void GpuProfiler::endUploadScope(VkCommandBuffer commandBuffer, uint32_t scope)
+{
+    if (scope == UINT32_MAX)
+        return;
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, uploadPool, scope * 2 + 1);
+}
+
+const std::vector<GpuTiming>& GpuProfiler::getUploadTimings()
+{
+    for (uint32_t scope = 0; scope < uploadScopes.size(); ++scope)
+    {
+        if (uploadScopes[scope].resolved)
+            continue;
+
+        float milliseconds = 0.0f;
+        if (readDuration(uploadPool, scope * 2, milliseconds))
+        {
+            uploadScopes[scope].resolved = true;
+            uploadTimings.push_back({uploadScopes[scope].name, milliseconds});
+        }
+    }
+
+    return uploadTimings;
+}
+
+void GpuProfiler::printUploadTimings()
+{
+    const auto& timings = getUploadTimings();
+    if (timings.empty())
+        return;
+
+    std::cout << "gpu upload timings (ms):\n";
+    for (const auto& timing : timings)
+        std::cout << '\t' << timing.name << ": " << timing.milliseconds << '\n';
+}
+
+bool GpuProfiler::readDuration(VkQueryPool pool, uint32_t firstQuery, float& milliseconds)
+{
+    // No WAIT_BIT, queries that are not available yet return VK_NOT_READY instead of blocking
+    uint64_t timestamps[2] = {};
+    if (vkGetQueryPoolResults(LogicalDevicesMgr::device, pool, firstQuery, 2, sizeof(timestamps), timestamps, sizeof(uint64_t),
+                              VK_QUERY_RESULT_64_BIT) != VK_SUCCESS)
+        return false;
+
+    const uint64_t ticks = (timestamps[1] - timestamps[0]) & timestampMask;
+    milliseconds = static_cast<float>(static_cast<double>(ticks) * timestampPeriod / 1e6);
+    return true;
+}
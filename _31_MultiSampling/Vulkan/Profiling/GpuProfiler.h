@@ -0,0 +1,57 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <vector>
+
+struct GpuTiming
+{
+    const char* name = nullptr;
+    float milliseconds = 0.0f;
+};
+
+// Timestamp queries around the render pass of every frame in flight and around upload work. Results are only read once the
+// GPU is known to be done with them, so reading never stalls; the render pass time of a frame is reported to the FrameProfiler
+// by the frame that reuses its slot, i.e. framesInFlight frames later.
+class GpuProfiler
+{
+public:
+    static void createProfiler();
+    static void destroyProfiler();
+
+    // One query pool per frame in flight, recreated when the number of frames in flight changes
+    static void createFrameScopes();
+    static void destroyFrameScopes();
+
+    static void beginFrameScope(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+    static void endFrameScope(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+    // Call after the fence of frameIndex has signalled, before the slot is recorded again
+    static void collectFrame(uint32_t frameIndex);
+
+    // Returns an id for endUploadScope, or UINT32_MAX when timestamps are unsupported or every upload scope has been used
+    static uint32_t beginUploadScope(VkCommandBuffer commandBuffer, const char* name);
+    static void endUploadScope(VkCommandBuffer commandBuffer, uint32_t scope);
+    static const std::vector<GpuTiming>& getUploadTimings();
+    static void printUploadTimings();
+
+    static uint32_t uploadScopeCapacity;
+
+private:
+    struct UploadScope
+    {
+        const char* name;
+        bool resolved;
+    };
+
+    static bool readDuration(VkQueryPool pool, uint32_t firstQuery, float& milliseconds);
+
+    static bool supported;
+    static float timestampPeriod; // Nanoseconds per tick
+    static uint64_t timestampMask;
+
+    static std::vector<VkQueryPool> framePools;
+    static std::vector<bool> frameScopesWritten;
+
+    static VkQueryPool uploadPool;
+    static std::vector<UploadScope> uploadScopes;
+    static std::vector<GpuTiming> uploadTimings;
+};
@@ -5,6 +5,7 @@ struct QueueFamilyIndices
 {
     std::optional<uint32_t> graphicsFamily;
     std::optional<uint32_t> presentFamily;
+    std::optional<uint32_t> transferFamily; // Only set for a family without graphics support, uploads use the graphics queue otherwise
     bool isComplete();
 };
 
@@ -12,23 +12,36 @@ QueueFamilyIndices QueueFamilyMgr::findQueueFamilies(VkPhysicalDevice device)
     std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
     vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
 
-    int i = 0;
+    bool transferFamilyIsTransferOnly = false;
+    uint32_t i = 0;
     for (const auto& queueFamily : queueFamilies)
     {
         if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
         {
-            indices.graphicsFamily = i;
+            if (!indices.graphicsFamily.has_value())
+                indices.graphicsFamily = i;
+        }
+        else if (queueFamily.queueFlags & (VK_QUEUE_TRANSFER_BIT | VK_QUEUE_COMPUTE_BIT))
+        {
+            // A transfer only family is usually backed by a DMA engine, prefer it over an async compute family
+            const bool transferOnly = !(queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT);
+            if (!indices.transferFamily.has_value() || (transferOnly && !transferFamilyIsTransferOnly))
+            {
+                indices.transferFamily = i;
+                transferFamilyIsTransferOnly = transferOnly;
+            }
         }
 
+        // Without a surface nothing is presented, the present queue then simply aliases the graphics queue
         VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, SurfaceMgr::surface, &presentSupport);
+        if (SurfaceMgr::hasSurface())
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, SurfaceMgr::surface, &presentSupport);
+        else
+            presentSupport = (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
 
-        if (presentSupport)
+        if (presentSupport && !indices.presentFamily.has_value())
             indices.presentFamily = i;
 
-        if (indices.isComplete())
-            break;
-
         ++i;
     }
 
@@ -15,6 +15,9 @@ void SurfaceMgr::createSurface(VkInstance instance, GLFWwindow* window)
 
 void SurfaceMgr::destroySurface( VkInstance instance)
 {
+    if (!hasSurface())
+        return;
+
     vkDestroySurfaceKHR(instance, surface, nullptr);
 }
 
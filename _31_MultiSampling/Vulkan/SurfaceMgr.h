@@ -7,6 +7,8 @@ class SurfaceMgr
 public:
     static void createSurface(VkInstance instance, GLFWwindow* window);
     static void destroySurface(VkInstance instance);
+    // Headless runs never create a surface, everything that presents checks this instead of a separate flag
+    static bool hasSurface() { return surface != VK_NULL_HANDLE; }
     static VkSurfaceKHR surface;
 };
 
@@ -3,14 +3,19 @@
 #include <iostream>
 #include <stdexcept>
 
+#include "../DeletionQueueMgr.h"
 #include "../DepthBufferMgr.h"
 #include "../FrameBuffersMgr.h"
 #include "../LogicalDevicesMgr.h"
+#include "../MsaaMgr.h"
 #include "../PhysicalDevicesMgr.h"
 #include "../SurfaceMgr.h"
 #include "../QueueFamily/QueueFamilyIndices.h"
 #include "../QueueFamily/QueueFamilyMgr.h"
 #include "../../HelloTriangleApplication.h"
+#include "../GraphicPipeline/GraphicsPipelineMgr.h"
+#include "../Memory/MemoryAllocatorMgr.h"
+#include "../Textures/TextureMgr.h"
 #include "../Utils/ImageHelper.h"
 
 VkSwapchainKHR SwapChainMgr::swapChain{};
@@ -18,6 +23,11 @@ std::vector<VkImage> SwapChainMgr::images = {};
 std::vector<VkImageView> SwapChainMgr::imageViews = {};
 VkFormat SwapChainMgr::imageFormat = VK_FORMAT_UNDEFINED;
 VkExtent2D SwapChainMgr::imageExtent = {0, 0};
+VkExtent2D SwapChainMgr::offscreenExtent = {800, 600};
+// One image per frame slot at the largest frames in flight setting, so a slot never renders into an image still in use
+uint32_t SwapChainMgr::offscreenImageCount = GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT;
+std::vector<MemoryAllocation> SwapChainMgr::offscreenImagesMemory{};
+uint32_t SwapChainMgr::nextOffscreenImage = 0;
 
 SwapChainSupportDetails SwapChainMgr::querySwapChainSupport(VkPhysicalDevice device)
 {
@@ -83,8 +93,14 @@ VkExtent2D SwapChainMgr::chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabi
     return actualExtent;
 }
 
-void SwapChainMgr::createSwapChain()
+void SwapChainMgr::createSwapChain(VkSwapchainKHR oldSwapChain)
 {
+    if (!SurfaceMgr::hasSurface())
+    {
+        createOffscreenImages();
+        return;
+    }
+
     SwapChainSupportDetails swapChainSupport = querySwapChainSupport(PhysicalDevicesMgr::physicalDevice);
     VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
     VkPresentModeKHR presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
@@ -123,7 +139,7 @@ void SwapChainMgr::createSwapChain()
     createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     createInfo.presentMode = presentMode;
     createInfo.clipped = VK_TRUE;
-    createInfo.oldSwapchain = VK_NULL_HANDLE;
+    createInfo.oldSwapchain = oldSwapChain;
 
     if (vkCreateSwapchainKHR(LogicalDevicesMgr::device, &createInfo, nullptr, &swapChain) != VK_SUCCESS)
     {
@@ -137,6 +153,61 @@ void SwapChainMgr::createSwapChain()
     imageExtent = extent;
 }
 
+void SwapChainMgr::createOffscreenImages()
+{
+    // Every implementation supports this format as a color attachment, and it matches what surfaces usually offer
+    imageFormat = VK_FORMAT_B8G8R8A8_SRGB;
+    imageExtent = offscreenExtent;
+    images.resize(offscreenImageCount);
+    offscreenImagesMemory.resize(offscreenImageCount);
+    nextOffscreenImage = 0;
+
+    for (uint32_t i = 0; i < offscreenImageCount; ++i)
+    {
+        TextureMgr::createImage(imageExtent.width, imageExtent.height, 1, VK_SAMPLE_COUNT_1_BIT, imageFormat, VK_IMAGE_TILING_OPTIMAL,
+                                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                images[i], offscreenImagesMemory[i]);
+    }
+}
+
+VkResult SwapChainMgr::acquireNextImage(VkSemaphore imageAvailableSemaphore, uint32_t& imageIndex)
+{
+    if (!SurfaceMgr::hasSurface())
+    {
+        // Images are handed out round robin. Before a frame is recorded it waits on the timeline value of the frame
+        // framesInFlight submissions back, and the ring is at least that long, so the previous user of this image is done
+        imageIndex = nextOffscreenImage;
+        nextOffscreenImage = (nextOffscreenImage + 1) % static_cast<uint32_t>(images.size());
+        return VK_SUCCESS;
+    }
+
+    return vkAcquireNextImageKHR(LogicalDevicesMgr::device, swapChain, UINT64_MAX, imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+}
+
+VkResult SwapChainMgr::present(VkSemaphore renderFinishedSemaphore, uint32_t imageIndex)
+{
+    if (!SurfaceMgr::hasSurface())
+        return VK_SUCCESS;
+
+    VkPresentInfoKHR presentInfo{};
+    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+
+    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pWaitSemaphores = &renderFinishedSemaphore;
+
+    presentInfo.swapchainCount = 1;
+    presentInfo.pSwapchains = &swapChain;
+    presentInfo.pImageIndices = &imageIndex;
+
+    return vkQueuePresentKHR(LogicalDevicesMgr::presentQueue, &presentInfo);
+}
+
+VkImageLayout SwapChainMgr::getFinalLayout()
+{
+    // Offscreen images are left ready to be copied out
+    return SurfaceMgr::hasSurface() ? VK_IMAGE_LAYOUT_PRESENT_SRC_KHR : VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+}
+
 void SwapChainMgr::recreateSwapChain()
 {
     int width = 0, height = 0;
@@ -147,15 +218,32 @@ void SwapChainMgr::recreateSwapChain()
         glfwWaitEvents();
     }
 
-    vkDeviceWaitIdle(LogicalDevicesMgr::device);
+    // Frames in flight may still render into the old images, so everything sized by them is handed to the deletion queue and
+    // destroyed once the GPU timeline has passed the last submission instead of draining the device here
+    const VkSwapchainKHR oldSwapChain = swapChain;
+    DeletionQueueMgr::defer([oldSwapChain, framebuffers = FrameBuffersMgr::swapChainFramebuffers, views = imageViews,
+            depthImage = DepthBufferMgr::depthImage, depthView = DepthBufferMgr::depthImageView, depthMemory = DepthBufferMgr::depthImageMemory,
+            colorImage = MsaaMgr::colorImage, colorView = MsaaMgr::colorImageView, colorMemory = MsaaMgr::colorImageMemory]() mutable
+    {
+        for (VkFramebuffer framebuffer : framebuffers)
+            vkDestroyFramebuffer(LogicalDevicesMgr::device, framebuffer, nullptr);
+        for (VkImageView view : views)
+            vkDestroyImageView(LogicalDevicesMgr::device, view, nullptr);
+
+        vkDestroyImageView(LogicalDevicesMgr::device, depthView, nullptr);
+        vkDestroyImage(LogicalDevicesMgr::device, depthImage, nullptr);
+        MemoryAllocatorMgr::freeMemory(depthMemory);
+
+        vkDestroyImageView(LogicalDevicesMgr::device, colorView, nullptr);
+        vkDestroyImage(LogicalDevicesMgr::device, colorImage, nullptr);
+        MemoryAllocatorMgr::freeMemory(colorMemory);
 
-    FrameBuffersMgr::destroyFramebuffers();
-    destroyImageViews();
-    destroySwapChain();
-    DepthBufferMgr::destroyDepthResources();
+        vkDestroySwapchainKHR(LogicalDevicesMgr::device, oldSwapChain, nullptr);
+    });
 
-    createSwapChain();
+    createSwapChain(oldSwapChain);
     createImageViews();
+    MsaaMgr::createColorResources();
     DepthBufferMgr::createDepthResources();
     FrameBuffersMgr::createFramebuffers();
 }
@@ -172,6 +260,16 @@ void SwapChainMgr::createImageViews()
 
 void SwapChainMgr::destroySwapChain()
 {
+    if (!SurfaceMgr::hasSurface())
+    {
+        for (size_t i = 0; i < images.size(); ++i)
+        {
+            vkDestroyImage(LogicalDevicesMgr::device, images[i], nullptr);
+            MemoryAllocatorMgr::freeMemory(offscreenImagesMemory[i]);
+        }
+        return;
+    }
+
     vkDestroySwapchainKHR(LogicalDevicesMgr::device, swapChain, nullptr);
 }
 
@@ -3,25 +3,41 @@
 #include "SwapChainSupportDetails.h"
 #include <vulkan/vulkan_core.h>
 
+#include "../Memory/MemoryAllocation.h"
+
 class SwapChainMgr
 {
 public:
     static SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);
     static void recreateSwapChain();
-    static void createSwapChain();
+    // Passing the swapchain being replaced lets the presentation engine hand its resources over to the new one
+    static void createSwapChain(VkSwapchainKHR oldSwapChain = VK_NULL_HANDLE);
     static void createImageViews();
     static void destroySwapChain();
     static void destroyImageViews();
+
+    // Without a surface these cycle through an internal ring of offscreen images, so drawFrame is the same in both modes
+    static VkResult acquireNextImage(VkSemaphore imageAvailableSemaphore, uint32_t& imageIndex);
+    static VkResult present(VkSemaphore renderFinishedSemaphore, uint32_t imageIndex);
+    static VkImageLayout getFinalLayout();
+
     static VkSwapchainKHR swapChain;
     static std::vector<VkImage> images;
     static std::vector<VkImageView> imageViews;
     static VkFormat imageFormat;
     static VkExtent2D imageExtent;
 
+    static VkExtent2D offscreenExtent;
+    static uint32_t offscreenImageCount;
+
 private:
     static VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats);
     static VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);
     static VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities);
+    static void createOffscreenImages();
+
+    static std::vector<MemoryAllocation> offscreenImagesMemory;
+    static uint32_t nextOffscreenImage;
 };
 
 
@@ -10,7 +10,8 @@ public:
     static void destroySyncObjects(); 
     static std::vector<VkSemaphore> imageAvailableSemaphores;
     static std::vector<VkSemaphore> renderFinishedSemaphores;
-    static std::vector<VkFence> inFlightFences;
+    // GPU timeline value signalled by the last submission of each frame slot, 0 when the slot has not been used yet
+    static std::vector<uint64_t> frameTimelineValues;
 };
 
 
@@ -7,11 +7,14 @@
 #include "../LogicalDevicesMgr.h"
 #include "../PhysicalDevicesMgr.h"
 #include "../CommandBuffers/CommandBuffersMgr.h"
+#include "../Memory/MemoryAllocatorMgr.h"
+#include "../Memory/StagingBufferMgr.h"
+#include "../Profiling/GpuProfiler.h"
 #include "../Utils/BufferHelper.h"
 #include "../Utils/ImageHelper.h"
 
 VkImage TextureMgr::textureImage = nullptr;
-VkDeviceMemory TextureMgr::textureImageMemory = nullptr;
+MemoryAllocation TextureMgr::textureImageMemory{};
 VkImageView TextureMgr::textureImageView = nullptr;
 VkSampler TextureMgr::textureSampler = nullptr;
 uint32_t TextureMgr::mipLevels = 0;
@@ -26,31 +29,25 @@ void TextureMgr::createTextureImage(std::string path)
     if (!pixels)
         throw std::runtime_error("Failed to load texture image!");
 
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-
-    BufferHelper::createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-    void* data;
-    vkMapMemory(LogicalDevicesMgr::device, stagingBufferMemory, 0, imageSize, 0, &data);
-    memcpy(data, pixels, imageSize);
-    vkUnmapMemory(LogicalDevicesMgr::device, stagingBufferMemory);
+    const StagingRegion staging = StagingBufferMgr::allocate(imageSize);
+    memcpy(staging.mappedData, pixels, imageSize);
     stbi_image_free(pixels);
 
     createImage(texWidth, texHeight, mipLevels, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R8G8B8A8_SRGB,
                 VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageMemory);
 
-    transitionImageLayout(textureImage, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels);
-    copyBufferToImage(stagingBuffer, textureImage, static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight));
-
-    vkDestroyBuffer(LogicalDevicesMgr::device, stagingBuffer, nullptr);
-    vkFreeMemory(LogicalDevicesMgr::device, stagingBufferMemory, nullptr);
-
-    generateMipmaps(textureImage, VK_FORMAT_R8G8B8A8_SRGB, texWidth, texHeight, mipLevels);
+    // Recorded into the current upload batch, nothing here waits for the GPU. Blits need the graphics queue, so only the copy
+    // runs on the transfer queue
+    const UploadCommandBuffers upload = CommandBuffersMgr::beginUploadBatch();
+    transitionImageLayout(upload.transfer, textureImage, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels);
+    copyBufferToImage(upload.transfer, staging.buffer, staging.offset, textureImage, static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight));
+    ImageHelper::transferImageOwnership(upload, textureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                        VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+    generateMipmaps(upload.graphics, textureImage, VK_FORMAT_R8G8B8A8_SRGB, texWidth, texHeight, mipLevels);
 }
 
-void TextureMgr::generateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels)
+void TextureMgr::generateMipmaps(VkCommandBuffer commandBuffer, VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels)
 {
     VkFormatProperties formatProperties;
     vkGetPhysicalDeviceFormatProperties(PhysicalDevicesMgr::physicalDevice, imageFormat, &formatProperties);
@@ -59,7 +56,8 @@ void TextureMgr::generateMipmaps(VkImage image, VkFormat imageFormat, int32_t te
         throw std::runtime_error("Texture image format does not support linear blitting!");
     }
 
-    VkCommandBuffer commandBuffer = CommandBuffersMgr::beginSingleTimeCommands();
+    const uint32_t profilerScope = GpuProfiler::beginUploadScope(commandBuffer, "generateMipmaps");
+
     VkImageMemoryBarrier barrier = {};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.image = image;
@@ -127,19 +125,19 @@ void TextureMgr::generateMipmaps(VkImage image, VkFormat imageFormat, int32_t te
                          0, nullptr,
                          1, &barrier);
 
-    CommandBuffersMgr::endSingleTimeCommands(commandBuffer);
+    GpuProfiler::endUploadScope(commandBuffer, profilerScope);
 }
 
 
 void TextureMgr::destroyTextureImage()
 {
     vkDestroyImage(LogicalDevicesMgr::device, textureImage, nullptr);
-    vkFreeMemory(LogicalDevicesMgr::device, textureImageMemory, nullptr);
+    MemoryAllocatorMgr::freeMemory(textureImageMemory);
 }
 
 void TextureMgr::createImage(uint32_t width, uint32_t height, uint32_t mipmapLevels, VkSampleCountFlagBits numSamples, VkFormat format,
                              VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image,
-                             VkDeviceMemory& imageMemory)
+                             MemoryAllocation& imageMemory)
 {    VkImageCreateInfo imageInfo = {};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imageInfo.imageType = VK_IMAGE_TYPE_2D;
@@ -164,23 +162,14 @@ void TextureMgr::createImage(uint32_t width, uint32_t height, uint32_t mipmapLev
     VkMemoryRequirements memRequirements;
     vkGetImageMemoryRequirements(LogicalDevicesMgr::device, image, &memRequirements);
 
-    VkMemoryAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = BufferHelper::findSuitableMemoryType(memRequirements.memoryTypeBits, properties);
+    const MemoryResourceKind kind = tiling == VK_IMAGE_TILING_OPTIMAL ? MemoryResourceKind::Optimal : MemoryResourceKind::Linear;
+    imageMemory = MemoryAllocatorMgr::allocateMemory(memRequirements, properties, kind);
 
-    if (vkAllocateMemory(LogicalDevicesMgr::device, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS)
-    {
-        throw std::runtime_error("Failed to allocate image memory!");
-    }
-
-    vkBindImageMemory(LogicalDevicesMgr::device, image, imageMemory, 0);
+    vkBindImageMemory(LogicalDevicesMgr::device, image, imageMemory.memory, imageMemory.offset);
 }
 
-void TextureMgr::transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipmapLevels)
+void TextureMgr::transitionImageLayout(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipmapLevels)
 {
-    VkCommandBuffer commandBuffer = CommandBuffersMgr::beginSingleTimeCommands();
-
     VkImageMemoryBarrier barrier = {};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.oldLayout = oldLayout;
@@ -223,17 +212,13 @@ void TextureMgr::transitionImageLayout(VkImage image, VkFormat format, VkImageLa
                          0, nullptr,
                          0, nullptr,
                          1, &barrier);
-
-    CommandBuffersMgr::endSingleTimeCommands(commandBuffer);
 }
 
 
-void TextureMgr::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height)
+void TextureMgr::copyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize bufferOffset, VkImage image, uint32_t width, uint32_t height)
 {
-    VkCommandBuffer commandBuffer = CommandBuffersMgr::beginSingleTimeCommands();
-
     VkBufferImageCopy region = {};
-    region.bufferOffset = 0;
+    region.bufferOffset = bufferOffset;
     region.bufferRowLength = 0;
     region.bufferImageHeight = 0;
     region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -244,8 +229,6 @@ void TextureMgr::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t widt
     region.imageExtent = {width, height, 1};
 
     vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-    CommandBuffersMgr::endSingleTimeCommands(commandBuffer);
 }
 
 void TextureMgr::createTextureImageView()
@@ -3,6 +3,8 @@
 
 #include <string>
 
+#include "../Memory/MemoryAllocation.h"
+
 class TextureMgr
 {
 public:
@@ -15,16 +17,16 @@ public:
     static void createTextureSampler();
     static void destroyTextureSampler();
 
-    static void transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipmapLevels);
-    static void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
+    static void transitionImageLayout(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipmapLevels);
+    static void copyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize bufferOffset, VkImage image, uint32_t width, uint32_t height);
     static void createImage(uint32_t width, uint32_t height, uint32_t mipmapLevels, VkSampleCountFlagBits numSamples, VkFormat format,
                             VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image,
-                            VkDeviceMemory& imageMemory);
-    static void generateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels);
+                            MemoryAllocation& imageMemory);
+    static void generateMipmaps(VkCommandBuffer commandBuffer, VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels);
 
     static uint32_t mipLevels;
     static VkImage textureImage;
-    static VkDeviceMemory textureImageMemory;
+    static MemoryAllocation textureImageMemory;
     static VkImageView textureImageView;
     static VkSampler textureSampler;
 };
\ No newline at end of file
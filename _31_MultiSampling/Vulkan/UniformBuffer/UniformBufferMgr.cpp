@@ -1,12 +1,14 @@
 #include "UniformBufferMgr.h"
 #include <vulkan/vulkan_core.h>
 
-#include <chrono>
+#include <algorithm>
 #include <stdexcept>
 
 #include "UniformBufferObject.h"
 #include "../LogicalDevicesMgr.h"
 #include "../GraphicPipeline/GraphicsPipelineMgr.h"
+#include "../Instancing/InstanceBufferMgr.h"
+#include "../Memory/MemoryAllocatorMgr.h"
 #include "../Utils/BufferHelper.h"
 #include "../SwapChain/SwapChainMgr.h"
 
@@ -18,47 +20,49 @@
 #include "../Textures/TextureMgr.h"
 
 std::vector<VkBuffer> UniformBufferMgr::uniformBuffers{};
-std::vector<VkDeviceMemory> UniformBufferMgr::uniformBuffersMemory{};
+std::vector<MemoryAllocation> UniformBufferMgr::uniformBuffersMemory{};
 std::vector<void*> UniformBufferMgr::uniformBuffersMapped{};
+glm::mat4 UniformBufferMgr::viewProjection{1.0f};
 
 void UniformBufferMgr::createUniformBuffers()
 {
-    uniformBuffers.resize(GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT);
-    uniformBuffersMemory.resize(GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT);
-    uniformBuffersMapped.resize(GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT);
+    uniformBuffers.resize(GraphicsPipelineMgr::framesInFlight);
+    uniformBuffersMemory.resize(GraphicsPipelineMgr::framesInFlight);
+    uniformBuffersMapped.resize(GraphicsPipelineMgr::framesInFlight);
 
-    for (size_t i = 0; i != GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT; ++i)
+    for (size_t i = 0; i != GraphicsPipelineMgr::framesInFlight; ++i)
     {
         constexpr VkDeviceSize bufferSize = sizeof(UniformBufferObject);
         BufferHelper::createBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
                                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                                    uniformBuffers[i], uniformBuffersMemory[i]);
 
-        vkMapMemory(LogicalDevicesMgr::device, uniformBuffersMemory[i], 0, bufferSize, 0, &uniformBuffersMapped[i]);
+        // Host visible blocks stay mapped for their whole lifetime, so the pointer can be used directly
+        uniformBuffersMapped[i] = uniformBuffersMemory[i].mappedData;
     }
 }
 
 void UniformBufferMgr::destroyUniformBuffers()
 {
-    for (size_t i = 0; i != GraphicsPipelineMgr::MAX_FRAMES_IN_FLIGHT; ++i)
+    for (size_t i = 0; i != GraphicsPipelineMgr::framesInFlight; ++i)
     {
         vkDestroyBuffer(LogicalDevicesMgr::device, uniformBuffers[i], nullptr);
-        vkFreeMemory(LogicalDevicesMgr::device, uniformBuffersMemory[i], nullptr);
+        MemoryAllocatorMgr::freeMemory(uniformBuffersMemory[i]);
     }
 }
 
 void UniformBufferMgr::updateUniformBuffer(uint32_t currentImage)
 {
-    static auto startTime = std::chrono::high_resolution_clock::now();
-    const auto currentTime = std::chrono::high_resolution_clock::now();
-    const float time = std::chrono::duration<float>(currentTime - startTime).count();
+    // Model matrices come from the instance buffer, the camera backs off until the whole instance grid is in view
+    const float distanceScale = std::max(1.0f, InstanceBufferMgr::getGridRadius());
 
     UniformBufferObject ubo;
     const VkExtent2D& extent = SwapChainMgr::imageExtent;
-    ubo.model = rotate(glm::mat4(1.0f), time * glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-    ubo.view = lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-    ubo.proj = glm::perspective(glm::radians(45.0f), static_cast<float>(extent.width) / static_cast<float>(extent.height), 0.1f, 10.0f);
+    ubo.view = lookAt(glm::vec3(2.0f, 2.0f, 2.0f) * distanceScale, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    ubo.proj = glm::perspective(glm::radians(45.0f), static_cast<float>(extent.width) / static_cast<float>(extent.height), 0.1f,
+                                10.0f * distanceScale);
     ubo.proj[1][1] *= -1;
+    viewProjection = ubo.proj * ubo.view;
     memcpy(uniformBuffersMapped[currentImage], &ubo, sizeof(ubo));
 }
 
@@ -3,6 +3,10 @@
 
 #include <vector>
 
+#include <glm/glm.hpp>
+
+#include "../Memory/MemoryAllocation.h"
+
 class UniformBufferMgr
 {
 public:
@@ -13,8 +17,10 @@ public:
     static void updateUniformBuffer(uint32_t currentImage);
 
     static std::vector<VkBuffer> uniformBuffers;
-    static std::vector<VkDeviceMemory> uniformBuffersMemory;
+    static std::vector<MemoryAllocation> uniformBuffersMemory;
     static std::vector<void*> uniformBuffersMapped;
+    // proj * view of the last update, the culling pass derives its frustum from it
+    static glm::mat4 viewProjection;
 };
 
 
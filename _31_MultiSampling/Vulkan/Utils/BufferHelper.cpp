@@ -4,21 +4,52 @@
 
 #include "../LogicalDevicesMgr.h"
 #include "../PhysicalDevicesMgr.h"
-#include "../CommandBuffers/CommandBuffersMgr.h"
+#include "../Memory/MemoryAllocatorMgr.h"
 
-void BufferHelper::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
+void BufferHelper::copyBuffer(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkDeviceSize srcOffset, VkBuffer dstBuffer, VkDeviceSize size,
+                              VkDeviceSize dstOffset)
 {
-    VkCommandBuffer commandBuffer = CommandBuffersMgr::beginSingleTimeCommands();
-
     VkBufferCopy copyRegion = {};
+    copyRegion.srcOffset = srcOffset;
+    copyRegion.dstOffset = dstOffset;
     copyRegion.size = size;
     vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+}
+
+void BufferHelper::insertBufferBarrier(VkCommandBuffer commandBuffer, VkBuffer buffer, VkPipelineStageFlags srcStages, VkAccessFlags srcAccess,
+                                       VkPipelineStageFlags dstStages, VkAccessFlags dstAccess, uint32_t srcQueueFamily, uint32_t dstQueueFamily)
+{
+    VkBufferMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+    barrier.srcQueueFamilyIndex = srcQueueFamily;
+    barrier.dstQueueFamilyIndex = dstQueueFamily;
+    barrier.buffer = buffer;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(commandBuffer, srcStages, dstStages, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
+void BufferHelper::transferBufferOwnership(const UploadCommandBuffers& upload, VkBuffer buffer, VkPipelineStageFlags dstStages, VkAccessFlags dstAccess)
+{
+    if (upload.transfer == upload.graphics)
+    {
+        insertBufferBarrier(upload.graphics, buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, dstStages, dstAccess);
+        return;
+    }
 
-    CommandBuffersMgr::endSingleTimeCommands(commandBuffer);
+    // Release only makes the writes available, the acquire on the graphics queue makes them visible to dstAccess
+    insertBufferBarrier(upload.transfer, buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                        LogicalDevicesMgr::transferQueueFamily, LogicalDevicesMgr::graphicsQueueFamily);
+    insertBufferBarrier(upload.graphics, buffer, dstStages, 0, dstStages, dstAccess,
+                        LogicalDevicesMgr::transferQueueFamily, LogicalDevicesMgr::graphicsQueueFamily);
 }
 
 void BufferHelper::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer,
-                                VkDeviceMemory& bufferMemory)
+                                MemoryAllocation& bufferMemory)
 {
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -34,17 +65,9 @@ void BufferHelper::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkM
     VkMemoryRequirements memRequirements;
     vkGetBufferMemoryRequirements(LogicalDevicesMgr::device, buffer, &memRequirements);
 
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findSuitableMemoryType(memRequirements.memoryTypeBits, properties);
-
-    if (vkAllocateMemory(LogicalDevicesMgr::device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS)
-    {
-        throw std::runtime_error("failed to allocate vertex buffer memory");
-    }
+    bufferMemory = MemoryAllocatorMgr::allocateMemory(memRequirements, properties, MemoryResourceKind::Linear);
 
-    vkBindBufferMemory(LogicalDevicesMgr::device, buffer, bufferMemory, 0);
+    vkBindBufferMemory(LogicalDevicesMgr::device, buffer, bufferMemory.memory, bufferMemory.offset);
 }
 
 uint32_t BufferHelper::findSuitableMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties)
@@ -1,12 +1,21 @@
 #pragma once
 #include <vulkan/vulkan_core.h>
 
+#include "../CommandBuffers/CommandBuffersMgr.h"
+#include "../Memory/MemoryAllocation.h"
+
 class BufferHelper
 {
 public:
     static void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer,
-                             VkDeviceMemory& bufferMemory);
-    static void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
+                             MemoryAllocation& bufferMemory);
+    static void copyBuffer(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkDeviceSize srcOffset, VkBuffer dstBuffer, VkDeviceSize size,
+                           VkDeviceSize dstOffset = 0);
+    static void insertBufferBarrier(VkCommandBuffer commandBuffer, VkBuffer buffer, VkPipelineStageFlags srcStages, VkAccessFlags srcAccess,
+                                    VkPipelineStageFlags dstStages, VkAccessFlags dstAccess,
+                                    uint32_t srcQueueFamily = VK_QUEUE_FAMILY_IGNORED, uint32_t dstQueueFamily = VK_QUEUE_FAMILY_IGNORED);
+    // Makes the transfer writes to buffer visible to the graphics queue, releasing and acquiring ownership when uploads use a separate family
+    static void transferBufferOwnership(const UploadCommandBuffers& upload, VkBuffer buffer, VkPipelineStageFlags dstStages, VkAccessFlags dstAccess);
     static uint32_t findSuitableMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 };
 
@@ -0,0 +1,32 @@
+#include "FileHelper.h"
+
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+bool FileHelper::writeFileAtomically(const std::string& path, std::initializer_list<FileChunk> chunks, std::string& error)
+{
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        for (const FileChunk& chunk : chunks)
+            file.write(static_cast<const char*>(chunk.data), static_cast<std::streamsize>(chunk.size));
+        if (!file)
+        {
+            error = "I/O error on " + temporaryPath;
+            file.close();
+            std::error_code ignored;
+            std::filesystem::remove(temporaryPath, ignored);
+            return false;
+        }
+    }
+
+    std::error_code renameError;
+    std::filesystem::rename(temporaryPath, path, renameError);
+    if (renameError)
+    {
+        error = renameError.message();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+
+struct FileChunk
+{
+    const void* data;
+    size_t size;
+};
+
+class FileHelper
+{
+public:
+    // Writes the chunks back to back next to path and renames the result over it, so a crash never leaves a truncated file
+    // behind. On failure path is untouched and error says why.
+    static bool writeFileAtomically(const std::string& path, std::initializer_list<FileChunk> chunks, std::string& error);
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// 64 bit FNV-1a. The result only depends on the bytes, so it is stable across runs and may be written to disk.
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+inline uint64_t hashBytes(const void* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Chain calls to hash a struct field by field, hashing a whole struct would feed its padding in
+template <typename T>
+uint64_t hashValue(const T& value, uint64_t hash = FNV_OFFSET_BASIS)
+{
+    static_assert(std::has_unique_object_representations_v<T> || std::is_floating_point_v<T>, "value has padding bytes");
+    return hashBytes(&value, sizeof(T), hash);
+}
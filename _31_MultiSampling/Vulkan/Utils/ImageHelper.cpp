@@ -29,3 +29,39 @@ VkImageView ImageHelper::createImageView(VkImage image, VkFormat format, VkImage
 
     return imageView;
 }
+
+void ImageHelper::transferImageOwnership(const UploadCommandBuffers& upload, VkImage image, VkImageLayout layout, uint32_t mipLevels,
+                                         VkPipelineStageFlags dstStages, VkAccessFlags dstAccess)
+{
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = layout;
+    barrier.newLayout = layout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = mipLevels;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+
+    if (upload.transfer == upload.graphics)
+    {
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = dstAccess;
+        vkCmdPipelineBarrier(upload.graphics, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStages, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+        return;
+    }
+
+    barrier.srcQueueFamilyIndex = LogicalDevicesMgr::transferQueueFamily;
+    barrier.dstQueueFamilyIndex = LogicalDevicesMgr::graphicsQueueFamily;
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = 0;
+    vkCmdPipelineBarrier(upload.transfer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = dstAccess;
+    vkCmdPipelineBarrier(upload.graphics, dstStages, dstStages, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
@@ -1,10 +1,15 @@
 #pragma once
 #include <vulkan/vulkan_core.h>
 
+#include "../CommandBuffers/CommandBuffersMgr.h"
+
 class ImageHelper
 {
 public:
     static VkImageView createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels);
+    // Hands a color image written by the transfer half of an upload batch to the graphics half, the layout is kept
+    static void transferImageOwnership(const UploadCommandBuffers& upload, VkImage image, VkImageLayout layout, uint32_t mipLevels,
+                                       VkPipelineStageFlags dstStages, VkAccessFlags dstAccess);
 };
 
 
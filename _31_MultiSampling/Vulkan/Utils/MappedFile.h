@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read only view of a whole file through the OS page cache, nothing is copied until the bytes are touched
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Returns false when the file does not exist or cannot be mapped, empty files map to a null view
+    bool open(const std::string& path);
+    void close();
+
+    const void* data() const { return view; }
+    size_t size() const { return viewSize; }
+    bool isOpen() const { return view != nullptr; }
+
+private:
+    const void* view = nullptr;
+    size_t viewSize = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
@@ -0,0 +1,125 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+{
+    threadCount = std::max(threadCount, 1u);
+    workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+        workers.emplace_back([this]() { workerLoop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+ThreadPool& ThreadPool::getShared()
+{
+    static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u));
+    return pool;
+}
+
+void ThreadPool::workerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty())
+                return;
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+bool ThreadPool::runPendingTask()
+{
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty())
+            return false;
+
+        task = std::move(tasks.front());
+        tasks.pop_front();
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body)
+{
+    if (count == 0)
+        return;
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    const size_t rangeCount = (count + grainSize - 1) / grainSize;
+    if (rangeCount == 1)
+    {
+        body(0, count);
+        return;
+    }
+
+    // Ranges are claimed from a shared counter, so a slow range never holds up the others
+    std::atomic<size_t> nextRange{0};
+    const auto runRanges = [&]()
+    {
+        for (size_t range = nextRange++; range < rangeCount; range = nextRange++)
+            body(range * grainSize, std::min(count, (range + 1) * grainSize));
+    };
+
+    const size_t helperCount = std::min<size_t>(workers.size(), rangeCount - 1);
+    std::vector<std::future<void>> helpers;
+    helpers.reserve(helperCount);
+    for (size_t i = 0; i < helperCount; ++i)
+        helpers.push_back(submit(runRanges));
+
+    std::exception_ptr error;
+    try
+    {
+        runRanges();
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+        nextRange = rangeCount;
+    }
+
+    // Every helper references locals of this frame, so all of them have to finish before an exception may leave it. Queued
+    // tasks are run while waiting, otherwise nested calls from busy workers could wait on helpers nobody is free to run.
+    for (auto& helper : helpers)
+    {
+        while (helper.wait_for(std::chrono::seconds(0)) != std::future_status::ready && runPendingTask())
+        {
+        }
+
+        try
+        {
+            helper.get();
+        }
+        catch (...)
+        {
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads fed from one FIFO queue. Exceptions thrown by a task are rethrown from its future.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(uint32_t threadCount);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <typename Function>
+    auto submit(Function&& function) -> std::future<std::invoke_result_t<std::decay_t<Function>>>
+    {
+        using Result = std::invoke_result_t<std::decay_t<Function>>;
+        // std::function needs a copyable target, the packaged task itself is move only
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+        std::future<Result> future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace_back([task]() { (*task)(); });
+        }
+        condition.notify_one();
+        return future;
+    }
+
+    // Calls body(begin, end) on consecutive ranges of at most grainSize items covering [0, count) and returns once all of them
+    // have run. The calling thread works on ranges too, so this may be called from inside a task without deadlocking.
+    void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body);
+
+    uint32_t getThreadCount() const { return static_cast<uint32_t>(workers.size()); }
+
+    // Lazily created pool with one worker per hardware thread
+    static ThreadPool& getShared();
+
+private:
+    void workerLoop();
+    // Runs one queued task on the calling thread, returns false when the queue is empty
+    bool runPendingTask();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+};
@@ -0,0 +1,283 @@
+#include "GeometryPoolMgr.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+#include "../DeletionQueueMgr.h"
+#include "../LogicalDevicesMgr.h"
+#include "../CommandBuffers/CommandBuffersMgr.h"
+#include "../Memory/MemoryAllocatorMgr.h"
+#include "../Memory/StagingBufferMgr.h"
+#include "../Utils/BufferHelper.h"
+
+VkDeviceSize GeometryPoolMgr::vertexPoolSize = 64ull * 1024 * 1024;
+VkDeviceSize GeometryPoolMgr::indexPoolSize = 32ull * 1024 * 1024;
+bool GeometryPoolMgr::splitLargeMeshes = true;
+std::vector<GeometryPage> GeometryPoolMgr::pages{};
+std::vector<PooledMesh> GeometryPoolMgr::meshes{};
+std::vector<uint32_t> GeometryPoolMgr::freeMeshes{};
+
+namespace
+{
+constexpr uint32_t SHORT_INDEX_VERTEX_LIMIT = 1u << 16;
+}
+
+void GeometryPoolMgr::destroyPool()
+{
+    for (auto& page : pages)
+    {
+        vkDestroyBuffer(LogicalDevicesMgr::device, page.vertexBuffer, nullptr);
+        MemoryAllocatorMgr::freeMemory(page.vertexBufferMemory);
+        vkDestroyBuffer(LogicalDevicesMgr::device, page.indexBuffer, nullptr);
+        MemoryAllocatorMgr::freeMemory(page.indexBufferMemory);
+    }
+
+    pages.clear();
+    meshes.clear();
+    freeMeshes.clear();
+}
+
+uint32_t GeometryPoolMgr::addMesh(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
+{
+    // Zero sized staging allocations and copies are invalid, and an empty mesh has nothing to draw anyway
+    if (vertexCount == 0 || indexCount == 0)
+        throw std::invalid_argument("geometry pool meshes need at least one vertex and one index!");
+
+    PooledMesh mesh;
+    mesh.vertexCount = vertexCount;
+    mesh.indexCount = indexCount;
+    mesh.quantization = GpuVertex::getQuantization(vertices, vertexCount);
+
+    glm::vec3 boundsMin = vertices[0].position;
+    glm::vec3 boundsMax = vertices[0].position;
+    for (uint32_t i = 1; i < vertexCount; ++i)
+    {
+        boundsMin = glm::min(boundsMin, vertices[i].position);
+        boundsMax = glm::max(boundsMax, vertices[i].position);
+    }
+    mesh.boundingSphere = glm::vec4((boundsMin + boundsMax) * 0.5f, glm::length(boundsMax - boundsMin) * 0.5f);
+
+    bool shortIndices = vertexCount < SHORT_INDEX_VERTEX_LIMIT;
+    mesh.draws.assign(1, {0, indexCount, 0});
+    if (!shortIndices && splitLargeMeshes)
+    {
+        std::vector<MeshDraw> splitDraws;
+        if (splitForShortIndices(indices, indexCount, vertexCount, splitDraws))
+        {
+            mesh.draws.swap(splitDraws);
+            shortIndices = true;
+        }
+    }
+    mesh.indexType = shortIndices ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+
+    const VkDeviceSize vertexSize = static_cast<VkDeviceSize>(GpuVertex::stride) * vertexCount;
+    const VkDeviceSize indexStride = shortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
+    const VkDeviceSize indexSize = indexStride * indexCount;
+
+    // Aligned to the element size, so the byte offsets convert to vertexOffset and firstIndex exactly
+    uint64_t vertexByteOffset = 0;
+    uint64_t indexByteOffset = 0;
+    allocateRanges(vertexSize, indexSize, indexStride, mesh, vertexByteOffset, indexByteOffset);
+
+    mesh.firstVertex = static_cast<uint32_t>(vertexByteOffset / GpuVertex::stride);
+    const auto firstIndex = static_cast<uint32_t>(indexByteOffset / indexStride);
+
+    const StagingRegion vertexStaging = StagingBufferMgr::allocate(vertexSize);
+    auto* vertexDestination = static_cast<uint8_t*>(vertexStaging.mappedData);
+    for (uint32_t i = 0; i < vertexCount; ++i)
+        GpuVertex::encode(vertices[i], mesh.quantization, vertexDestination + static_cast<size_t>(i) * GpuVertex::stride);
+
+    const StagingRegion indexStaging = StagingBufferMgr::allocate(indexSize);
+    if (shortIndices)
+    {
+        // Narrowed relative to the vertexOffset of the draw each index belongs to
+        auto* indexDestination = static_cast<uint16_t*>(indexStaging.mappedData);
+        for (const auto& draw : mesh.draws)
+        {
+            for (uint32_t i = draw.firstIndex; i < draw.firstIndex + draw.indexCount; ++i)
+            {
+                assert(indices[i] - static_cast<uint32_t>(draw.vertexOffset) < SHORT_INDEX_VERTEX_LIMIT);
+                indexDestination[i] = static_cast<uint16_t>(indices[i] - static_cast<uint32_t>(draw.vertexOffset));
+            }
+        }
+    }
+    else
+    {
+        memcpy(indexStaging.mappedData, indices, indexSize);
+    }
+
+    for (auto& draw : mesh.draws)
+    {
+        draw.firstIndex += firstIndex;
+        draw.vertexOffset += static_cast<int32_t>(mesh.firstVertex);
+    }
+
+    // Recorded on the graphics queue, a transfer queue would need an ownership transfer of the whole pool buffer for every mesh
+    const GeometryPage& page = pages[mesh.page];
+    const UploadCommandBuffers upload = CommandBuffersMgr::beginUploadBatch();
+    BufferHelper::copyBuffer(upload.graphics, vertexStaging.buffer, vertexStaging.offset, page.vertexBuffer, vertexSize, vertexByteOffset);
+    BufferHelper::copyBuffer(upload.graphics, indexStaging.buffer, indexStaging.offset, page.indexBuffer, indexSize, indexByteOffset);
+    BufferHelper::insertBufferBarrier(upload.graphics, page.vertexBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                      VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
+    BufferHelper::insertBufferBarrier(upload.graphics, page.indexBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                      VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT);
+
+    if (!freeMeshes.empty())
+    {
+        const uint32_t id = freeMeshes.back();
+        freeMeshes.pop_back();
+        meshes[id] = std::move(mesh);
+        return id;
+    }
+
+    meshes.push_back(std::move(mesh));
+    return static_cast<uint32_t>(meshes.size() - 1);
+}
+
+void GeometryPoolMgr::removeMesh(uint32_t mesh)
+{
+    const uint32_t page = meshes[mesh].page;
+    const uint32_t vertexNode = meshes[mesh].vertexNode;
+    const uint32_t indexNode = meshes[mesh].indexNode;
+    meshes[mesh] = PooledMesh{};
+
+    DeletionQueueMgr::defer([mesh, page, vertexNode, indexNode]()
+    {
+        pages[page].vertexAllocator->free(vertexNode);
+        pages[page].indexAllocator->free(indexNode);
+        freeMeshes.push_back(mesh);
+    });
+}
+
+void GeometryPoolMgr::drawMesh(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t mesh, uint32_t instanceCount,
+                               uint32_t firstInstance)
+{
+    const PooledMesh& pooledMesh = meshes[mesh];
+    bindMesh(commandBuffer, pipelineLayout, pooledMesh);
+    for (const auto& draw : pooledMesh.draws)
+        vkCmdDrawIndexed(commandBuffer, draw.indexCount, instanceCount, draw.firstIndex, draw.vertexOffset, firstInstance);
+}
+
+void GeometryPoolMgr::drawMeshIndirect(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t mesh, VkBuffer drawCommandBuffer,
+                                       VkDeviceSize offset)
+{
+    const PooledMesh& pooledMesh = meshes[mesh];
+    bindMesh(commandBuffer, pipelineLayout, pooledMesh);
+    // One command per call, drawing several at once would need the multiDrawIndirect feature
+    for (size_t draw = 0; draw < pooledMesh.draws.size(); ++draw)
+    {
+        vkCmdDrawIndexedIndirect(commandBuffer, drawCommandBuffer, offset + draw * sizeof(VkDrawIndexedIndirectCommand), 1,
+                                 sizeof(VkDrawIndexedIndirectCommand));
+    }
+}
+
+void GeometryPoolMgr::bindMesh(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const PooledMesh& mesh)
+{
+    MeshPushConstants pushConstants;
+    pushConstants.positionScale = glm::vec4(mesh.quantization.positionScale, 0.0f);
+    pushConstants.positionOffset = glm::vec4(mesh.quantization.positionOffset, 0.0f);
+    pushConstants.texCoordScaleOffset = glm::vec4(mesh.quantization.texCoordScale, mesh.quantization.texCoordOffset);
+    vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(pushConstants), &pushConstants);
+
+    const GeometryPage& page = pages[mesh.page];
+    constexpr VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &page.vertexBuffer, &offset);
+    vkCmdBindIndexBuffer(commandBuffer, page.indexBuffer, 0, mesh.indexType);
+}
+
+void GeometryPoolMgr::allocateRanges(VkDeviceSize vertexSize, VkDeviceSize indexSize, VkDeviceSize indexStride, PooledMesh& mesh,
+                                     uint64_t& vertexByteOffset, uint64_t& indexByteOffset)
+{
+    for (uint32_t page = 0; page < pages.size(); ++page)
+    {
+        if (allocateInPage(page, vertexSize, indexSize, indexStride, mesh, vertexByteOffset, indexByteOffset))
+            return;
+    }
+
+    // TLSF only serves a request from a list whose smallest range is large enough, so a page sized exactly for the mesh could
+    // still refuse it. The headroom covers the rounding to the next list and the alignment padding.
+    addPage(std::max(vertexPoolSize, vertexSize + vertexSize / 8 + GpuVertex::stride),
+            std::max(indexPoolSize, indexSize + indexSize / 8 + indexStride));
+    if (!allocateInPage(static_cast<uint32_t>(pages.size() - 1), vertexSize, indexSize, indexStride, mesh, vertexByteOffset,
+                        indexByteOffset))
+        throw std::runtime_error("failed to place mesh in a new geometry pool page!");
+}
+
+bool GeometryPoolMgr::allocateInPage(uint32_t page, VkDeviceSize vertexSize, VkDeviceSize indexSize, VkDeviceSize indexStride,
+                                     PooledMesh& mesh, uint64_t& vertexByteOffset, uint64_t& indexByteOffset)
+{
+    GeometryPage& geometryPage = pages[page];
+    const uint32_t vertexNode = geometryPage.vertexAllocator->allocate(vertexSize, GpuVertex::stride, vertexByteOffset);
+    if (vertexNode == TlsfAllocator::INVALID_NODE)
+        return false;
+
+    const uint32_t indexNode = geometryPage.indexAllocator->allocate(indexSize, indexStride, indexByteOffset);
+    if (indexNode == TlsfAllocator::INVALID_NODE)
+    {
+        geometryPage.vertexAllocator->free(vertexNode);
+        return false;
+    }
+
+    mesh.page = page;
+    mesh.vertexNode = vertexNode;
+    mesh.indexNode = indexNode;
+    return true;
+}
+
+void GeometryPoolMgr::addPage(VkDeviceSize vertexSize, VkDeviceSize indexSize)
+{
+    GeometryPage page;
+    BufferHelper::createBuffer(vertexSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, page.vertexBuffer, page.vertexBufferMemory);
+    BufferHelper::createBuffer(indexSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, page.indexBuffer, page.indexBufferMemory);
+    page.vertexAllocator = std::make_unique<TlsfAllocator>(vertexSize);
+    page.indexAllocator = std::make_unique<TlsfAllocator>(indexSize);
+    pages.push_back(std::move(page));
+}
+
+bool GeometryPoolMgr::splitForShortIndices(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount, std::vector<MeshDraw>& draws)
+{
+    // Greedy over whole triangles in index order. After MeshOptimizer the vertices are in first use order, so the vertex range a
+    // run of triangles touches grows slowly and splits are rare.
+    draws.clear();
+    MeshDraw draw;
+    uint32_t minVertex = UINT32_MAX;
+    uint32_t maxVertex = 0;
+    for (uint32_t triangle = 0; triangle + 3 <= indexCount; triangle += 3)
+    {
+        const uint32_t* corners = indices + triangle;
+        const uint32_t triangleMin = std::min({corners[0], corners[1], corners[2]});
+        const uint32_t triangleMax = std::max({corners[0], corners[1], corners[2]});
+        // Not even a draw of its own can reach this triangle with 16 bit indices
+        if (triangleMax - triangleMin >= SHORT_INDEX_VERTEX_LIMIT)
+            return false;
+        const uint32_t newMin = std::min(minVertex, triangleMin);
+        const uint32_t newMax = std::max(maxVertex, triangleMax);
+
+        if (draw.indexCount > 0 && newMax - newMin >= SHORT_INDEX_VERTEX_LIMIT)
+        {
+            draw.vertexOffset = static_cast<int32_t>(minVertex);
+            draws.push_back(draw);
+            draw = {triangle, 0, 0};
+            minVertex = triangleMin;
+            maxVertex = triangleMax;
+        }
+        else
+        {
+            minVertex = newMin;
+            maxVertex = newMax;
+        }
+        draw.indexCount += 3;
+    }
+
+    if (draw.indexCount > 0)
+    {
+        draw.vertexOffset = static_cast<int32_t>(minVertex);
+        draws.push_back(draw);
+    }
+
+    // Badly ordered meshes end up with many tiny draws, 32 bit indices are cheaper then
+    return draws.size() <= 2 * (vertexCount / SHORT_INDEX_VERTEX_LIMIT + 1);
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <memory>
+#include <vector>
+
+#include "Vertex.h"
+#include "VertexLayout.h"
+#include "../Memory/MemoryAllocation.h"
+#include "../Memory/TlsfAllocator.h"
+
+// One vkCmdDrawIndexed over part of a mesh. Meshes with too many vertices for 16 bit indices are split into draws that each
+// reach at most 65536 vertices starting at vertexOffset. Both offsets are absolute inside the buffers of the mesh's page.
+struct MeshDraw
+{
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    int32_t vertexOffset = 0;
+};
+
+struct PooledMesh
+{
+    uint32_t page = 0;
+    uint32_t firstVertex = 0;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+    std::vector<MeshDraw> draws;
+    VertexQuantization quantization;
+    glm::vec4 boundingSphere{0.0f}; // Mesh space center and radius, for culling
+
+    uint32_t vertexNode = TlsfAllocator::INVALID_NODE;
+    uint32_t indexNode = TlsfAllocator::INVALID_NODE;
+};
+
+// Matches the push constant block of Triangle.vert, the quantization of the mesh being drawn
+struct MeshPushConstants
+{
+    glm::vec4 positionScale;
+    glm::vec4 positionOffset;
+    glm::vec4 texCoordScaleOffset;
+};
+
+// One shared vertex buffer and one shared index buffer, suballocated with TLSF
+struct GeometryPage
+{
+    VkBuffer vertexBuffer = VK_NULL_HANDLE;
+    VkBuffer indexBuffer = VK_NULL_HANDLE;
+    MemoryAllocation vertexBufferMemory{};
+    MemoryAllocation indexBufferMemory{};
+    std::unique_ptr<TlsfAllocator> vertexAllocator;
+    std::unique_ptr<TlsfAllocator> indexAllocator;
+};
+
+// Meshes share the buffers of a page, a new page is added whenever a mesh fits into none of the existing ones. 16 and 32 bit
+// indices share the index buffer, each range is aligned to its index size so firstIndex stays exact for either binding.
+class GeometryPoolMgr
+{
+public:
+    static constexpr uint32_t INVALID_MESH = UINT32_MAX;
+
+    static void destroyPool();
+
+    // Encodes the vertices as GpuVertex and records the upload into the current upload batch. Throws when the mesh is empty.
+    static uint32_t addMesh(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+    // The mesh id and its ranges are reused once the GPU is done with everything submitted so far
+    static void removeMesh(uint32_t mesh);
+    static const PooledMesh& getMesh(uint32_t mesh) { return meshes[mesh]; }
+
+    // Pushes the quantization of the mesh, binds the buffers of its page with its index type and records its draws
+    static void drawMesh(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t mesh, uint32_t instanceCount = 1,
+                         uint32_t firstInstance = 0);
+    // Same, but the draws come from one VkDrawIndexedIndirectCommand per MeshDraw starting at offset
+    static void drawMeshIndirect(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t mesh, VkBuffer drawCommandBuffer,
+                                 VkDeviceSize offset);
+
+    // Buffer sizes of a page, a mesh that needs more gets a page sized for it
+    static VkDeviceSize vertexPoolSize;
+    static VkDeviceSize indexPoolSize;
+    // Split meshes with more than 65536 vertices instead of falling back to 32 bit indices
+    static bool splitLargeMeshes;
+
+private:
+    static void bindMesh(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const PooledMesh& mesh);
+    static bool splitForShortIndices(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount, std::vector<MeshDraw>& draws);
+    // Places both ranges of the mesh in the first page that holds them, adding a page when none does
+    static void allocateRanges(VkDeviceSize vertexSize, VkDeviceSize indexSize, VkDeviceSize indexStride, PooledMesh& mesh,
+                               uint64_t& vertexByteOffset, uint64_t& indexByteOffset);
+    static bool allocateInPage(uint32_t page, VkDeviceSize vertexSize, VkDeviceSize indexSize, VkDeviceSize indexStride,
+                               PooledMesh& mesh, uint64_t& vertexByteOffset, uint64_t& indexByteOffset);
+    static void addPage(VkDeviceSize vertexSize, VkDeviceSize indexSize);
+
+    static std::vector<GeometryPage> pages;
+    static std::vector<PooledMesh> meshes;
+    static std::vector<uint32_t> freeMeshes;
+};
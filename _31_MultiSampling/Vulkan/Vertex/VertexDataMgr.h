@@ -2,24 +2,24 @@
 #include <vector>
 #include "Vertex.h"
 
+// What the vertex and index buffers are filled from, either the vectors below or a memory mapped mesh cache
+struct MeshData
+{
+    const Vertex* vertices = nullptr;
+    uint32_t vertexCount = 0;
+    const uint32_t* indices = nullptr;
+    uint32_t indexCount = 0;
+};
+
 class VertexDataMgr
 {
 public:
     static std::vector<Vertex> vertices;
     static std::vector<uint32_t> indices;
-    static void createVertexBuffer();
-    static void createIndexBuffer();
-    static void destroyVertexBuffer();
-    static void destroyIndexBuffer();
-    
-    static VkBuffer vertexBuffer;
-    static VkDeviceMemory vertexBufferMemory;
-
-    static VkBuffer indexBuffer;
-    static VkDeviceMemory indexBufferMemory;
-
-private:
-    static uint32_t findSuitableMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+    static MeshData meshData;
+    // The model inside GeometryPoolMgr, set by uploadModel
+    static uint32_t modelMesh;
+    static void uploadModel();
 };
 
 
@@ -0,0 +1,99 @@
+#include "VertexHashTable.h"
+
+#include <cstring>
+#include <utility>
+
+namespace
+{
+size_t roundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 16;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+uint64_t mix(uint64_t value)
+{
+    // Finalizer of MurmurHash3, every input bit affects every output bit
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ull;
+    value ^= value >> 33;
+    return value;
+}
+}
+
+VertexHashTable::VertexHashTable(std::vector<Vertex>& vertices, size_t expectedVertices) : vertices(vertices)
+{
+    // Keeps the load factor at or below one half when every index turns out to be unique
+    slots.assign(roundUpToPowerOfTwo(expectedVertices * 2), Slot{0, EMPTY_SLOT});
+    mask = slots.size() - 1;
+}
+
+uint64_t VertexHashTable::hash(const Vertex& vertex)
+{
+    static_assert(sizeof(Vertex) % sizeof(uint32_t) == 0, "Vertex must be made of 32 bit components");
+
+    uint32_t words[sizeof(Vertex) / sizeof(uint32_t)];
+    std::memcpy(words, &vertex, sizeof(Vertex));
+
+    uint64_t hash = 0x9e3779b97f4a7c15ull;
+    for (uint32_t word : words)
+    {
+        // -0.0 and 0.0 compare equal, so they have to hash the same
+        if (word == 0x80000000u)
+            word = 0;
+        hash = (hash ^ word) * 0x100000001b3ull;
+        hash = (hash << 31) | (hash >> 33);
+    }
+    return mix(hash);
+}
+
+uint32_t VertexHashTable::insertOrFind(const Vertex& vertex)
+{
+    return insertOrFind(vertex, hash(vertex));
+}
+
+uint32_t VertexHashTable::insertOrFind(const Vertex& vertex, uint64_t vertexHash)
+{
+    if ((count + 1) * 4 > slots.size() * 3)
+        grow();
+
+    const auto tag = static_cast<uint32_t>(vertexHash >> 32);
+    for (size_t position = vertexHash & mask;; position = (position + 1) & mask)
+    {
+        Slot& slot = slots[position];
+        if (slot.index == EMPTY_SLOT)
+        {
+            slot.tag = tag;
+            slot.index = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(vertex);
+            ++count;
+            return slot.index;
+        }
+
+        if (slot.tag == tag && vertices[slot.index] == vertex)
+            return slot.index;
+    }
+}
+
+void VertexHashTable::grow()
+{
+    const std::vector<Slot> oldSlots = std::move(slots);
+    slots.assign(oldSlots.size() * 2, Slot{0, EMPTY_SLOT});
+    mask = slots.size() - 1;
+
+    // The full hash is not stored, so it is recomputed from the vertex the slot points to
+    for (const Slot& oldSlot : oldSlots)
+    {
+        if (oldSlot.index == EMPTY_SLOT)
+            continue;
+
+        size_t position = hash(vertices[oldSlot.index]) & mask;
+        while (slots[position].index != EMPTY_SLOT)
+            position = (position + 1) & mask;
+        slots[position] = oldSlot;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Vertex.h"
+
+// Flat open addressing table used to deduplicate vertices while a model is parsed. Slots only hold an index into the vertex
+// array plus a hash tag, so a lookup touches one cache line in the common case and never allocates per vertex.
+class VertexHashTable
+{
+public:
+    // expectedVertices is an upper bound on the unique vertex count, e.g. the index count of the model
+    VertexHashTable(std::vector<Vertex>& vertices, size_t expectedVertices);
+
+    // Returns the index of an equal vertex, appending the vertex to the array first when it has not been seen yet
+    uint32_t insertOrFind(const Vertex& vertex);
+    // Same as above with the result of hash(vertex) computed by the caller
+    uint32_t insertOrFind(const Vertex& vertex, uint64_t vertexHash);
+
+    static uint64_t hash(const Vertex& vertex);
+
+private:
+    struct Slot
+    {
+        uint32_t tag;   // High bits of the hash, rejects most mismatches without reading the vertex
+        uint32_t index; // EMPTY_SLOT when unused
+    };
+
+    static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+    void grow();
+
+    std::vector<Vertex>& vertices;
+    std::vector<Slot> slots;
+    size_t mask = 0;
+    size_t count = 0;
+};
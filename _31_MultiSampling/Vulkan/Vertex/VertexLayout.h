@@ -0,0 +1,207 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include "Vertex.h"
+
+// Maps quantized attributes back to their original range, Triangle.vert applies value * scale + offset to position and texCoord.
+// Attributes stored at full precision keep the identity mapping.
+struct VertexQuantization
+{
+    glm::vec3 positionScale{1.0f};
+    glm::vec3 positionOffset{0.0f};
+    glm::vec2 texCoordScale{1.0f};
+    glm::vec2 texCoordOffset{0.0f};
+};
+
+enum class VertexSemantic
+{
+    Position,
+    Color,
+    TexCoord
+};
+
+// Attribute encodings. Each one names the shader location it feeds, its Vulkan format, the bytes it occupies and how a Vertex
+// is written into them. Three component 16 bit formats are rarely supported as vertex input, so positions are padded to four.
+
+struct PositionFloat3
+{
+    static constexpr VertexSemantic semantic = VertexSemantic::Position;
+    static constexpr bool normalized = false;
+    static constexpr uint32_t location = 0;
+    static constexpr VkFormat format = VK_FORMAT_R32G32B32_SFLOAT;
+    static constexpr uint32_t size = 12;
+
+    static void encode(const Vertex& vertex, const VertexQuantization&, uint8_t* destination)
+    {
+        std::memcpy(destination, &vertex.position, size);
+    }
+};
+
+struct PositionHalf4
+{
+    static constexpr VertexSemantic semantic = VertexSemantic::Position;
+    static constexpr bool normalized = true;
+    static constexpr uint32_t location = 0;
+    static constexpr VkFormat format = VK_FORMAT_R16G16B16A16_SFLOAT;
+    static constexpr uint32_t size = 8;
+
+    static void encode(const Vertex& vertex, const VertexQuantization& quantization, uint8_t* destination)
+    {
+        const glm::vec3 normalizedPosition = (vertex.position - quantization.positionOffset) / quantization.positionScale;
+        const glm::uvec2 packed{glm::packHalf2x16({normalizedPosition.x, normalizedPosition.y}), glm::packHalf2x16({normalizedPosition.z, 0.0f})};
+        std::memcpy(destination, &packed, size);
+    }
+};
+
+struct PositionUnorm16
+{
+    static constexpr VertexSemantic semantic = VertexSemantic::Position;
+    static constexpr bool normalized = true;
+    static constexpr uint32_t location = 0;
+    static constexpr VkFormat format = VK_FORMAT_R16G16B16A16_UNORM;
+    static constexpr uint32_t size = 8;
+
+    static void encode(const Vertex& vertex, const VertexQuantization& quantization, uint8_t* destination)
+    {
+        const glm::vec3 normalizedPosition = (vertex.position - quantization.positionOffset) / quantization.positionScale;
+        const glm::uvec2 packed{glm::packUnorm2x16({normalizedPosition.x, normalizedPosition.y}), glm::packUnorm2x16({normalizedPosition.z, 0.0f})};
+        std::memcpy(destination, &packed, size);
+    }
+};
+
+struct ColorFloat3
+{
+    static constexpr VertexSemantic semantic = VertexSemantic::Color;
+    static constexpr bool normalized = false;
+    static constexpr uint32_t location = 1;
+    static constexpr VkFormat format = VK_FORMAT_R32G32B32_SFLOAT;
+    static constexpr uint32_t size = 12;
+
+    static void encode(const Vertex& vertex, const VertexQuantization&, uint8_t* destination)
+    {
+        std::memcpy(destination, &vertex.color, size);
+    }
+};
+
+struct TexCoordFloat2
+{
+    static constexpr VertexSemantic semantic = VertexSemantic::TexCoord;
+    static constexpr bool normalized = false;
+    static constexpr uint32_t location = 2;
+    static constexpr VkFormat format = VK_FORMAT_R32G32_SFLOAT;
+    static constexpr uint32_t size = 8;
+
+    static void encode(const Vertex& vertex, const VertexQuantization&, uint8_t* destination)
+    {
+        std::memcpy(destination, &vertex.texCoord, size);
+    }
+};
+
+struct TexCoordUnorm16
+{
+    static constexpr VertexSemantic semantic = VertexSemantic::TexCoord;
+    static constexpr bool normalized = true;
+    static constexpr uint32_t location = 2;
+    static constexpr VkFormat format = VK_FORMAT_R16G16_UNORM;
+    static constexpr uint32_t size = 4;
+
+    static void encode(const Vertex& vertex, const VertexQuantization& quantization, uint8_t* destination)
+    {
+        const uint32_t packed = glm::packUnorm2x16((vertex.texCoord - quantization.texCoordOffset) / quantization.texCoordScale);
+        std::memcpy(destination, &packed, size);
+    }
+};
+
+// The vertex as stored in the vertex buffer: the listed attributes packed back to back in order. Attributes that are left out
+// are not uploaded at all, the loader side keeps working with the full precision Vertex.
+template <typename... Attributes>
+class VertexLayout
+{
+    static_assert(sizeof...(Attributes) > 0, "a vertex layout needs at least one attribute");
+    static_assert(((Attributes::size % 4 == 0) && ...), "attributes must keep 4 byte alignment");
+
+public:
+    static constexpr uint32_t attributeCount = sizeof...(Attributes);
+    static constexpr uint32_t stride = (Attributes::size + ...);
+
+    static VkVertexInputBindingDescription getBindingDescription()
+    {
+        VkVertexInputBindingDescription bindingDescription = {};
+        bindingDescription.binding = 0;
+        bindingDescription.stride = stride;
+        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        return bindingDescription;
+    }
+
+    static std::array<VkVertexInputAttributeDescription, attributeCount> getAttributeDescriptions()
+    {
+        std::array<VkVertexInputAttributeDescription, attributeCount> attributeDescriptions = {};
+        uint32_t attribute = 0;
+        uint32_t offset = 0;
+        ((attributeDescriptions[attribute++] = {Attributes::location, 0, Attributes::format, offset}, offset += Attributes::size), ...);
+        return attributeDescriptions;
+    }
+
+    // Normalized attributes are mapped onto the bounds of the mesh, the others keep the identity mapping
+    static VertexQuantization getQuantization(const Vertex* vertices, uint32_t vertexCount)
+    {
+        VertexQuantization quantization;
+        if (vertexCount == 0)
+            return quantization;
+
+        glm::vec3 positionMin = vertices[0].position;
+        glm::vec3 positionMax = vertices[0].position;
+        glm::vec2 texCoordMin = vertices[0].texCoord;
+        glm::vec2 texCoordMax = vertices[0].texCoord;
+        for (uint32_t i = 1; i < vertexCount; ++i)
+        {
+            positionMin = glm::min(positionMin, vertices[i].position);
+            positionMax = glm::max(positionMax, vertices[i].position);
+            texCoordMin = glm::min(texCoordMin, vertices[i].texCoord);
+            texCoordMax = glm::max(texCoordMax, vertices[i].texCoord);
+        }
+
+        // A flat axis would divide by zero, any scale encodes it exactly
+        if (isNormalized(VertexSemantic::Position))
+        {
+            quantization.positionOffset = positionMin;
+            quantization.positionScale = glm::max(positionMax - positionMin, glm::vec3(1e-20f));
+        }
+        if (isNormalized(VertexSemantic::TexCoord))
+        {
+            quantization.texCoordOffset = texCoordMin;
+            quantization.texCoordScale = glm::max(texCoordMax - texCoordMin, glm::vec2(1e-20f));
+        }
+        return quantization;
+    }
+
+    // Writes stride bytes
+    static void encode(const Vertex& vertex, const VertexQuantization& quantization, uint8_t* destination)
+    {
+        ((Attributes::encode(vertex, quantization, destination), destination += Attributes::size), ...);
+    }
+
+private:
+    static constexpr bool isNormalized(VertexSemantic semantic)
+    {
+        return ((Attributes::semantic == semantic && Attributes::normalized) || ...);
+    }
+};
+
+using FullPrecisionVertex = VertexLayout<PositionFloat3, ColorFloat3, TexCoordFloat2>;
+using QuantizedVertex = VertexLayout<PositionUnorm16, TexCoordUnorm16>;
+
+// Chosen at compile time. The default drops the vertex color and stores 12 instead of 32 bytes. Triangle.vert only reads the
+// color when VERTEX_COLOR is set, which needs the FullPrecision layout.
+#ifdef VERTEX_FULL_PRECISION
+using GpuVertex = FullPrecisionVertex;
+#else
+using GpuVertex = QuantizedVertex;
+#endif
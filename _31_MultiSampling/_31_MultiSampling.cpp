@@ -2,12 +2,21 @@
 #include <GLFW/glfw3.h>
 
 #include <iostream>
+#include "AppOptions.h"
 #include "HelloTriangleApplication.h"
+#include "Vulkan/Culling/CullingBenchmark.h"
 
-int main()
+int main(int argc, char* argv[])
 {
     try
     {
+        AppOptions::parse(argc, argv);
+        if (AppOptions::cullBenchmarkObjects != 0)
+        {
+            CullingBenchmark::run(AppOptions::cullBenchmarkObjects);
+            return EXIT_SUCCESS;
+        }
+
         HelloTriangleApplication app;
         app.run();
     }